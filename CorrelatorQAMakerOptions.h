@@ -142,7 +142,12 @@ namespace CorrelatorQAMakerOptions {
 
     SMakeClustQATreeConfig config = {
       .isEmbed     = true,
-      .clustAccept = GetClustAccept()
+      .doTree      = true,
+      .doHists     = false,
+      .doFlatTree  = false,
+      .clustAccept = GetClustAccept(),
+      .doTrkMatch  = false,
+      .trkAccept   = GetTrackAccept()
     };
     return config;
 
@@ -47,6 +47,8 @@ static const bool DebugDefault = false;
 // macro body -----------------------------------------------------------------
 
 void RunStandaloneCorrelatorQAModules(
+  const uint32_t iShard = 0,
+  const uint32_t nShards = 1,
   const vector<string>& vecOutFiles = VecOutFilesDefault,
   const vector<string>& vecOutDir = VecOutDirDefault,
   const vector<string>& vecInFiles = VecInFilesDefault,
@@ -58,6 +60,16 @@ void RunStandaloneCorrelatorQAModules(
 
   // get module configurations
   SReadLambdaJetTreeConfig cfg_readLambdaJetTree = CorrelatorQAMakerOptions::GetReadLambdaJetTreeConfig(vecInFiles.at(0));
+  cfg_readLambdaJetTree.iShard  = iShard;
+  cfg_readLambdaJetTree.nShards = nShards;
+
+  // if sharded, tag output with shard index
+  string outFile = vecOutFiles.at(0);
+  if (nShards > 1) {
+    const string shardTag = ".shard" + to_string(iShard) + "of" + to_string(nShards);
+    const size_t iExt     = outFile.rfind(".root");
+    outFile.insert((iExt != string::npos) ? iExt : outFile.size(), shardTag);
+  }
 
   // run qa makers ------------------------------------------------------------
 
@@ -66,7 +78,7 @@ void RunStandaloneCorrelatorQAModules(
   maker -> InitPlugin(cfg_readLambdaJetTree);
   maker -> SetGlobalVerbosity(verbosity);
   maker -> SetGlobalDebug(debug);
-  maker -> ReadLambdaJetTree() -> SetOutFile(vecOutFiles.at(0));
+  maker -> ReadLambdaJetTree() -> SetOutFile(outFile);
   maker -> ReadLambdaJetTree() -> SetOutDir(vecOutDir.at(0));
 
   // run plugins
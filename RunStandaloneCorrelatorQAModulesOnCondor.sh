@@ -5,8 +5,14 @@
 # 03.11.2024
 #
 # short script to run RunStandaloneCorrelatorQAModules.C via condor
+#
+# usage: RunStandaloneCorrelatorQAModulesOnCondor.sh <shard> <no. of shards>
 # -----------------------------------------------------------------------------
 
+# shard to process (defaults to whole input)
+ishard=${1:-0}
+nshards=${2:-1}
+
 # set up environment
 export USER="$(id -u -n)"
 export LOGNAME=${USER}
@@ -15,6 +21,6 @@ source /opt/sphenix/core/bin/sphenix_setup.sh
 printenv
 
 # run macro
-root -b -q RunStandaloneCorrelatorQAModules.cxx
+root -b -q "RunStandaloneCorrelatorQAModules.cxx(${ishard}, ${nshards})"
 
 # end -------------------------------------------------------------------------
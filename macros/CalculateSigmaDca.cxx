@@ -25,8 +25,11 @@
 #include <TObjArray.h>
 #include <TPaveText.h>
 #include <TGraphErrors.h>
+// analysis utilities
+#include "../src/SHistPolicy.h"
 
 using namespace std;
+using namespace SColdQcdCorrelatorAnalysis;
 
 // global constants
 static const size_t NDca(2);
@@ -60,6 +63,17 @@ void CalculateSigmaDca() {
   const string              sDcaXYvsZAll("hDcaXYvsZAll");
   const string              sDcaXYvsZSel("hDcaXYvsZSel");
 
+  // histogram storage: precision of each family and
+  // memory budget in MB (if over budget, the largest
+  // families are stepped down to float, then int)
+  SHistPolicy histPolicy;
+  histPolicy.vecFamilies = {
+    {"hDcaXYvsZ*", SHistPolicy::Double},
+    {"hDca*vsPt*", SHistPolicy::Double}
+  };
+  histPolicy.budgetMB   = 100.;
+  histPolicy.overBudget = SHistPolicy::Downgrade;
+
   // fit parameters
   const uint16_t            cut(0);
   const string              sDcaFit("gaus(0)");
@@ -153,10 +167,21 @@ void CalculateSigmaDca() {
   const tuple<size_t, pair<float, float>> dcaBins = {2000, make_pair(-5., 5.)};
   const tuple<size_t, pair<float, float>> ptBins  = {100,  make_pair(0.,  100.)};
 
+  // check histograms against memory budget
+  SHistBooker booker;
+  booker.SetPolicy(histPolicy);
+  for (size_t iDca = 0; iDca < NDca; iDca++) {
+    booker.Plan(sDcaVsPtAll[iDca], (get<0>(ptBins) + 2) * (get<0>(dcaBins) + 2));
+    booker.Plan(sDcaVsPtSel[iDca], (get<0>(ptBins) + 2) * (get<0>(dcaBins) + 2));
+  }
+  booker.Plan(sDcaXYvsZAll, (get<0>(dcaBins) + 2) * (get<0>(dcaBins) + 2));
+  booker.Plan(sDcaXYvsZSel, (get<0>(dcaBins) + 2) * (get<0>(dcaBins) + 2));
+  booker.Resolve();
+
   // declare histograms
   array<TH1D*, NDca> arrDcaWidth;
-  array<TH2D*, NDca> arrDcaVsPtAll;
-  array<TH2D*, NDca> arrDcaVsPtSel;
+  array<TH2*,  NDca> arrDcaVsPtAll;
+  array<TH2*,  NDca> arrDcaVsPtSel;
   for (size_t iDca = 0; iDca < NDca; iDca++) {
     arrDcaWidth[iDca] = new TH1D(
       sWidthName[iDca].data(),
@@ -165,9 +190,9 @@ void CalculateSigmaDca() {
       get<1>(ptBins).first,
       get<1>(ptBins).second
     );
-    arrDcaVsPtAll[iDca] = new TH2D(
-      sDcaVsPtAll[iDca].data(),
-      sAll.data(),
+    arrDcaVsPtAll[iDca] = booker.Make2D(
+      sDcaVsPtAll[iDca],
+      sAll,
       get<0>(ptBins),
       get<1>(ptBins).first,
       get<1>(ptBins).second,
@@ -175,9 +200,9 @@ void CalculateSigmaDca() {
       get<1>(dcaBins).first,
       get<1>(dcaBins).second
     );
-    arrDcaVsPtSel[iDca] = new TH2D(
-      sDcaVsPtSel[iDca].data(),
-      sSel.data(),
+    arrDcaVsPtSel[iDca] = booker.Make2D(
+      sDcaVsPtSel[iDca],
+      sSel,
       get<0>(ptBins),
       get<1>(ptBins).first,
       get<1>(ptBins).second,
@@ -187,9 +212,9 @@ void CalculateSigmaDca() {
     );
   }
 
-  TH2D* hDcaXYvsZAll = new TH2D(
-    sDcaXYvsZAll.data(),
-    sAll.data(),
+  TH2* hDcaXYvsZAll = booker.Make2D(
+    sDcaXYvsZAll,
+    sAll,
     get<0>(dcaBins),
     get<1>(dcaBins).first,
     get<1>(dcaBins).second,
@@ -197,9 +222,9 @@ void CalculateSigmaDca() {
     get<1>(dcaBins).first,
     get<1>(dcaBins).second
   );
-  TH2D* hDcaXYvsZSel = new TH2D(
-    sDcaXYvsZSel.data(),
-    sSel.data(),
+  TH2* hDcaXYvsZSel = booker.Make2D(
+    sDcaXYvsZSel,
+    sSel,
     get<0>(dcaBins),
     get<1>(dcaBins).first,
     get<1>(dcaBins).second,
@@ -0,0 +1,467 @@
+// ----------------------------------------------------------------------------
+// 'MergeQAHistograms.cxx'
+// Derek Anderson
+// 04.06.2024
+//
+// Merges the histogram outputs of the QA plugins
+// (e.g. one file per condor shard) into a single
+// file. Files are split into groups which are read
+// in parallel, and then the group results are merged
+// pairwise in a parallel tree reduction.
+//
+// Histograms are matched by their full path in the
+// file and must have identical binning to be merged.
+// Long64_t TParameters (no. of entries read, cut-flow
+// totals, shard info) are carried over: shard info is
+// checked and combined, everything else is summed.
+// Histograms saved as one key (a TList, e.g. with
+// saveSingleKey) are merged one by one and written
+// back as a single list. Other objects (e.g. trees) are skipped -- use hadd
+// for those.
+//
+// Usage:
+//   root -b -q 'MergeQAHistograms.cxx+("out.root", "in/*.root", 8)'
+// where the input can be a file, a glob, or a text
+// file (.list/.txt) with one file per line.
+// ----------------------------------------------------------------------------
+
+// c++ utilities
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <thread>
+#include <fstream>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <glob.h>
+// root classes
+#include <TH1.h>
+#include <TKey.h>
+#include <TClass.h>
+#include <TList.h>
+#include <TAxis.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TError.h>
+#include <TArrayD.h>
+#include <TDirectory.h>
+#include <TParameter.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+// merged contents of one or more files ---------------------------------------
+
+struct MergedOutput {
+
+  // histograms and Long64_t parameters by full path
+  map<string, TH1*>     hists;
+  map<string, Long64_t> params;
+
+  // path of the list a histogram was read from (only
+  // for histograms saved as one key)
+  map<string, string> lists;
+
+  // shard indices seen in each directory
+  map<string, vector<Long64_t>> shards;
+
+  // bookkeeping
+  uint64_t nFiles   = 0;
+  uint64_t nSkipped = 0;
+
+};  // end MergedOutput
+
+
+
+// helper functions -----------------------------------------------------------
+
+vector<string> ExpandInputs(const string input) {
+
+  vector<string> files;
+
+  // if a list file, expand each line
+  const bool isList = (
+    (input.size() > 5 && input.compare(input.size() - 5, 5, ".list") == 0) ||
+    (input.size() > 4 && input.compare(input.size() - 4, 4, ".txt") == 0)
+  );
+  if (isList) {
+    ifstream list(input.data());
+    string   line;
+    while (getline(list, line)) {
+      const size_t start = line.find_first_not_of(" \t");
+      if ((start == string::npos) || (line[start] == '#')) continue;
+
+      const size_t         stop  = line.find_last_not_of(" \t\r");
+      const vector<string> found = ExpandInputs(line.substr(start, stop - start + 1));
+      files.insert(files.end(), found.begin(), found.end());
+    }
+    return files;
+  }
+
+  // otherwise expand any wildcards
+  glob_t globbed;
+  if (glob(input.data(), 0, NULL, &globbed) == 0) {
+    for (size_t iPath = 0; iPath < globbed.gl_pathc; iPath++) {
+      files.push_back(globbed.gl_pathv[iPath]);
+    }
+  }
+  globfree(&globbed);
+  return files;
+
+}  // end 'ExpandInputs(string)'
+
+
+
+bool HaveSameAxis(const TAxis* axA, const TAxis* axB) {
+
+  if (axA -> GetNbins() != axB -> GetNbins()) return false;
+  if (axA -> GetXmin()  != axB -> GetXmin())  return false;
+  if (axA -> GetXmax()  != axB -> GetXmax())  return false;
+
+  // check edges of variable bins too
+  const TArrayD* edgesA = axA -> GetXbins();
+  const TArrayD* edgesB = axB -> GetXbins();
+  if (edgesA -> GetSize() != edgesB -> GetSize()) return false;
+  for (int iEdge = 0; iEdge < edgesA -> GetSize(); iEdge++) {
+    if (edgesA -> At(iEdge) != edgesB -> At(iEdge)) return false;
+  }
+  return true;
+
+}  // end 'HaveSameAxis(TAxis*, TAxis*)'
+
+
+
+bool HaveSameBinning(const TH1* histA, const TH1* histB) {
+
+  if (string(histA -> ClassName()) != string(histB -> ClassName())) return false;
+  if (histA -> GetDimension() != histB -> GetDimension())           return false;
+
+  bool isSame = HaveSameAxis(histA -> GetXaxis(), histB -> GetXaxis());
+  if (histA -> GetDimension() > 1) isSame = isSame && HaveSameAxis(histA -> GetYaxis(), histB -> GetYaxis());
+  if (histA -> GetDimension() > 2) isSame = isSame && HaveSameAxis(histA -> GetZaxis(), histB -> GetZaxis());
+  return isSame;
+
+}  // end 'HaveSameBinning(TH1*, TH1*)'
+
+
+
+void AddHist(MergedOutput& out, const string path, TH1* hist, const string source) {
+
+  // take ownership if first copy
+  auto itHist = out.hists.find(path);
+  if (itHist == out.hists.end()) {
+    out.hists[path] = hist;
+    return;
+  }
+
+  // otherwise check binning and add
+  if (!HaveSameBinning(itHist -> second, hist)) {
+    cerr << "WARNING: binning of \"" << path << "\" in " << source << " doesn't match! Skipping." << endl;
+    ++out.nSkipped;
+  } else {
+    itHist -> second -> Add(hist);
+  }
+  delete hist;
+  return;
+
+}  // end 'AddHist(MergedOutput&, string, TH1*, string)'
+
+
+
+void AddParam(MergedOutput& out, const string dir, const string name, const Long64_t value) {
+
+  const string path = dir + name;
+
+  // shard indices are collected
+  if (name == "iShard") {
+    out.shards[dir].push_back(value);
+    return;
+  }
+
+  // range is widened, no. of shards should agree,
+  // and everything else is summed
+  auto itParam = out.params.find(path);
+  if (itParam == out.params.end()) {
+    out.params[path] = value;
+  } else if (name == "firstEntry") {
+    itParam -> second = min(itParam -> second, value);
+  } else if (name == "lastEntry") {
+    itParam -> second = max(itParam -> second, value);
+  } else if (name == "nShards") {
+    if (itParam -> second != value) {
+      cerr << "WARNING: inputs have different no. of shards in \"" << dir << "\" (" << itParam -> second << " vs. " << value << ")!" << endl;
+    }
+    itParam -> second = max(itParam -> second, value);
+  } else {
+    itParam -> second += value;
+  }
+  return;
+
+}  // end 'AddParam(MergedOutput&, string, string, Long64_t)'
+
+
+
+void ReadList(MergedOutput& out, TList* list, const string path, const string name, const string source) {
+
+  // unlink contents first: histograms may be deleted
+  // once merged, and the list mustn't touch them after
+  vector<TObject*> vecObjs;
+  TIter next(list);
+  while (TObject* obj = next()) {
+    vecObjs.push_back(obj);
+  }
+  list -> Clear("nodelete");
+  delete list;
+
+  // histograms are merged by their path as if they
+  // were in a directory named after the list
+  for (TObject* obj : vecObjs) {
+    if (obj -> InheritsFrom(TH1::Class())) {
+      const string histPath = path + name + "/" + obj -> GetName();
+      out.lists[histPath] = path + name;
+      AddHist(out, histPath, (TH1*) obj, source);
+    } else {
+      ++out.nSkipped;
+      delete obj;
+    }
+  }
+  return;
+
+}  // end 'ReadList(MergedOutput&, TList*, string, string, string)'
+
+
+
+void ReadDirectory(MergedOutput& out, TDirectory* dir, const string path, const string source) {
+
+  // only read the latest cycle of each key
+  set<string> read;
+
+  TIter next(dir -> GetListOfKeys());
+  while (TKey* key = (TKey*) next()) {
+
+    const string name = key -> GetName();
+    if (read.count(name) > 0) continue;
+    read.insert(name);
+
+    // check type before reading anything
+    TClass* type = TClass::GetClass(key -> GetClassName());
+    if (!type) {
+      ++out.nSkipped;
+      continue;
+    }
+
+    if (type -> InheritsFrom(TDirectory::Class())) {
+      ReadDirectory(out, dir -> GetDirectory(name.data()), path + name + "/", source);
+    } else if (type -> InheritsFrom(TH1::Class())) {
+      AddHist(out, path + name, (TH1*) key -> ReadObj(), source);
+    } else if (type -> InheritsFrom(TList::Class())) {
+      ReadList(out, (TList*) key -> ReadObj(), path, name, source);
+    } else if (type -> InheritsFrom(TParameter<Long64_t>::Class())) {
+      TParameter<Long64_t>* param = (TParameter<Long64_t>*) key -> ReadObj();
+      AddParam(out, path, name, param -> GetVal());
+      delete param;
+    } else {
+      ++out.nSkipped;
+    }
+  }
+  return;
+
+}  // end 'ReadDirectory(MergedOutput&, TDirectory*, string, string)'
+
+
+
+void MergeInto(MergedOutput& out, MergedOutput& other) {
+
+  for (auto& hist : other.hists) {
+    AddHist(out, hist.first, hist.second, "merged group");
+  }
+  for (const auto& param : other.params) {
+    const size_t iSlash = param.first.rfind('/');
+    const string dir    = (iSlash == string::npos) ? "" : param.first.substr(0, iSlash + 1);
+    const string name   = (iSlash == string::npos) ? param.first : param.first.substr(iSlash + 1);
+    AddParam(out, dir, name, param.second);
+  }
+  out.lists.insert(other.lists.begin(), other.lists.end());
+  for (const auto& shard : other.shards) {
+    out.shards[shard.first].insert(out.shards[shard.first].end(), shard.second.begin(), shard.second.end());
+  }
+  out.nFiles   += other.nFiles;
+  out.nSkipped += other.nSkipped;
+
+  // histograms are now owned by out
+  other.hists.clear();
+  return;
+
+}  // end 'MergeInto(MergedOutput&, MergedOutput&)'
+
+
+
+TDirectory* GetOrMakeDirectory(TFile* file, const string dir) {
+
+  if (dir.empty()) return file;
+
+  TDirectory* out = file -> GetDirectory(dir.data());
+  if (!out) {
+    file -> mkdir(dir.data(), "", true);
+    out = file -> GetDirectory(dir.data());
+  }
+  return out;
+
+}  // end 'GetOrMakeDirectory(TFile*, string)'
+
+
+
+// merge histograms -----------------------------------------------------------
+
+void MergeQAHistograms(
+  const string sOutput = "merged.root",
+  const string sInput = "output/*.root",
+  const uint16_t nThreads = 4
+) {
+
+  // lower verbosity
+  gErrorIgnoreLevel = kError;
+  cout << "\n  Starting QA histogram merge..." << endl;
+
+  // histograms are owned here, not by files
+  ROOT::EnableThreadSafety();
+  TH1::AddDirectory(false);
+
+  // find inputs --------------------------------------------------------------
+
+  const vector<string> vecFiles = ExpandInputs(sInput);
+  if (vecFiles.empty()) {
+    cerr << "PANIC: no input files found for \"" << sInput << "\"!\n" << endl;
+    return;
+  }
+
+  const size_t nGroups = min((size_t) max(nThreads, (uint16_t) 1), vecFiles.size());
+  cout << "    Merging " << vecFiles.size() << " files in " << nGroups << " groups." << endl;
+
+  // read groups in parallel --------------------------------------------------
+
+  vector<MergedOutput> vecMerged(nGroups);
+  vector<thread>       vecThreads;
+  for (size_t iGroup = 0; iGroup < nGroups; iGroup++) {
+    vecThreads.emplace_back(
+      [&vecFiles, &vecMerged, iGroup, nGroups]() {
+
+        // each group gets a contiguous slice of files
+        const size_t iStart = (vecFiles.size() * iGroup) / nGroups;
+        const size_t iStop  = (vecFiles.size() * (iGroup + 1)) / nGroups;
+        for (size_t iFile = iStart; iFile < iStop; iFile++) {
+
+          TFile* file = TFile::Open(vecFiles[iFile].data(), "read");
+          if (!file || file -> IsZombie()) {
+            cerr << "WARNING: couldn't open \"" << vecFiles[iFile] << "\"! Skipping." << endl;
+            continue;
+          }
+          ReadDirectory(vecMerged[iGroup], file, "", vecFiles[iFile]);
+          ++vecMerged[iGroup].nFiles;
+
+          file -> Close();
+          delete file;
+        }
+      }
+    );
+  }
+  for (thread& thr : vecThreads) {
+    thr.join();
+  }
+  cout << "    Read all groups." << endl;
+
+  // tree reduction -----------------------------------------------------------
+
+  // merge pairs (0, 1), (2, 3), ... at each level
+  // until a single result is left
+  for (size_t step = 1; step < nGroups; step *= 2) {
+    vecThreads.clear();
+    for (size_t iGroup = 0; iGroup + step < nGroups; iGroup += 2 * step) {
+      vecThreads.emplace_back(
+        [&vecMerged, iGroup, step]() {
+          MergeInto(vecMerged[iGroup], vecMerged[iGroup + step]);
+        }
+      );
+    }
+    for (thread& thr : vecThreads) {
+      thr.join();
+    }
+  }
+  MergedOutput& merged = vecMerged.front();
+  cout << "    Merged " << merged.nFiles << " files: " << merged.hists.size() << " histograms." << endl;
+
+  // check shards -------------------------------------------------------------
+
+  for (auto& shard : merged.shards) {
+
+    vector<Long64_t>& indices = shard.second;
+    sort(indices.begin(), indices.end());
+
+    const Long64_t nShards   = merged.params[shard.first + "nShards"];
+    const bool     hasDupes  = (adjacent_find(indices.begin(), indices.end()) != indices.end());
+    const bool     isMissing = ((Long64_t) indices.size() < nShards);
+    if (hasDupes) {
+      cerr << "WARNING: some shards in \"" << shard.first << "\" were merged more than once!" << endl;
+    }
+    if (isMissing) {
+      cerr << "WARNING: only " << indices.size() << " of " << nShards << " shards in \"" << shard.first << "\" were found!" << endl;
+    }
+    merged.params[shard.first + "nShardsMerged"] = indices.size();
+  }
+
+  // save output --------------------------------------------------------------
+
+  TFile* fOutput = new TFile(sOutput.data(), "recreate");
+  if (!fOutput || fOutput -> IsZombie()) {
+    cerr << "PANIC: couldn't open output file \"" << sOutput << "\"!\n" << endl;
+    return;
+  }
+
+  // histograms read from lists are collected
+  // and written back as one key per list
+  map<string, TList> lists;
+  for (auto& hist : merged.hists) {
+    auto itList = merged.lists.find(hist.first);
+    if (itList != merged.lists.end()) {
+      lists[itList -> second].Add(hist.second);
+      continue;
+    }
+
+    const size_t iSlash = hist.first.rfind('/');
+    const string dir    = (iSlash == string::npos) ? "" : hist.first.substr(0, iSlash);
+    GetOrMakeDirectory(fOutput, dir) -> cd();
+    hist.second -> Write();
+    delete hist.second;
+  }
+  for (auto& list : lists) {
+    const size_t iSlash = list.first.rfind('/');
+    const string dir    = (iSlash == string::npos) ? "" : list.first.substr(0, iSlash);
+    const string name   = (iSlash == string::npos) ? list.first : list.first.substr(iSlash + 1);
+    GetOrMakeDirectory(fOutput, dir) -> cd();
+    list.second.Write(name.data(), TObject::kSingleKey);
+    list.second.Delete();
+  }
+  for (const auto& param : merged.params) {
+    const size_t iSlash = param.first.rfind('/');
+    const string dir    = (iSlash == string::npos) ? "" : param.first.substr(0, iSlash);
+    const string name   = (iSlash == string::npos) ? param.first : param.first.substr(iSlash + 1);
+    GetOrMakeDirectory(fOutput, dir) -> cd();
+    TParameter<Long64_t>(name.data(), param.second).Write();
+  }
+  fOutput -> Close();
+  cout << "    Saved merged output to \"" << sOutput << "\"." << endl;
+
+  // announce end
+  if (merged.nSkipped > 0) {
+    cout << "    WARNING: " << merged.nSkipped << " objects were skipped (mismatched binning or not histograms)." << endl;
+  }
+  cout << "  Finished QA histogram merge!\n" << endl;
+  return;
+
+}
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,19 @@
+#!/bin/bash
+# -----------------------------------------------------------------------------
+# 'RunQAHistogramMerge.sh'
+# Derek Anderson
+# 04.06.2024
+#
+# Small script to merge QA histogram outputs (e.g.
+# condor shards) with MergeQAHistograms.cxx
+#
+# usage: RunQAHistogramMerge.sh <output> <input glob or list> <no. of threads>
+# -----------------------------------------------------------------------------
+
+output=${1:-merged.root}
+input=${2:-output/*.root}
+nthreads=${3:-4}
+
+root -b -q "MergeQAHistograms.cxx+(\"${output}\", \"${input}\", ${nthreads})"
+
+# end -------------------------------------------------------------------------
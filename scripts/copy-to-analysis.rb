@@ -28,8 +28,10 @@ to_copy = [
   "scripts/copy-to-analysis.rb",
   "scripts/wipe-source.sh",
   "scripts/RunSigmaDcaCalculation.sh",
+  "scripts/RunQAHistogramMerge.sh",
   "macros/CalculateSigmaDca.cxx",
   "macros/QuickWeirdTuplePlotter.cxx",
+  "macros/MergeQAHistograms.cxx",
   "src/SCorrelatorQAMaker.cc",
   "src/SCorrelatorQAMaker.h",
   "src/SCorrelatorQAMakerLinkDef.h",
@@ -40,16 +42,27 @@ to_copy = [
   "src/SCheckTrackPairs.h",
   "src/SCheckTrackPairs.cc",
   "src/SCheckTrackPairsConfig.h",
+  "src/SCheckpoint.h",
+  "src/SEntryRange.h",
+  "src/SHistPolicy.h",
+  "src/SInputReader.h",
   "src/SMakeClustQATree.h",
   "src/SMakeClustQATree.cc",
   "src/SMakeClustQATreeConfig.h",
+  "src/SMakeClustQATreeHistDef.h",
+  "src/SMakeClustQATreeIndex.h",
   "src/SMakeClustQATreeOutput.h",
+  "src/SMakeClustQATreeRecord.h",
   "src/SMakeTrackQATuple.h",
   "src/SMakeTrackQATuple.cc",
   "src/SMakeTrackQATupleConfig.h",
+  "src/SProgressMeter.h",
   "src/SReadLambdaJetTree.h",
   "src/SReadLambdaJetTree.cc",
+  "src/SReadLambdaJetTreeBootstrap.h",
   "src/SReadLambdaJetTreeConfig.h",
+  "src/SReadLambdaJetTreeEvent.h",
+  "src/SReadLambdaJetTreeFillTable.h",
   "src/SReadLambdaJetTreeHistDef.h",
   "src/autogen.sh",
   "src/configure.ac",
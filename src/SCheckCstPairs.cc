@@ -73,27 +73,29 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SCheckCstPairs::InitInput() {
 
-
-    // open input files
-    m_fInput = new TFile(m_config.inFileName.data(), "read");
-    if (!m_fInput) {
-      cerr << "PANIC: couldn't open input file:\n"
+    // collect input files into a chain
+    m_cInput = new TChain(m_config.inChainName.data());
+    const int32_t nAdded = m_cInput -> Add(m_config.inFileName.data());
+    if (nAdded == 0) {
+      cerr << "PANIC: couldn't find input file(s):\n"
            << "       \"" << m_config.inFileName << "\"\n"
            << endl;
-      assert(m_fInput);
+      assert(nAdded > 0);
     }
-    cout << "    Opened input file:\n"
+    cout << "    Opened input file(s):\n"
          << "      \"" << m_config.inFileName << "\""
          << endl;
 
-    // grab input tree
-    m_cInput = (TChain*) m_fInput -> Get(m_config.inChainName.data());
-    if (!m_tInput) {
-      cerr << "PANIC: couldn't grab input chain \"" << m_config.inChainName << "\"!\n" << endl;
-      assert(m_cInput);
-    }
+    // open tree or rntuple in each file
+    m_reader = new SInputReader();
+    m_reader -> Open(m_cInput, m_config.inFormat);
     cout << "    Grabbed input chain \"" << m_config.inChainName << "\"." << endl;
 
+    // let rntuple decompress pages in parallel
+    if (m_reader -> IsNTuple() && (m_config.nUnzipThreads > 0)) {
+      ROOT::EnableImplicitMT(m_config.nUnzipThreads);
+    }
+
     // exit routine
     return;
 
@@ -103,54 +105,50 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SCheckCstPairs::InitTree() {
 
-    // set up input chain
-    m_fCurrent = -1;
-    m_cInput -> SetMakeClass(1);
-
     // set truth vs. reco branch addresses
     if (m_config.isInChainTruth) {
-      m_cInput -> SetBranchAddress("Parton3_ID",   &m_partonID.first,    &m_brPartonID.first);
-      m_cInput -> SetBranchAddress("Parton4_ID",   &m_partonID.second,   &m_brPartonID.second);
-      m_cInput -> SetBranchAddress("Parton3_MomX", &m_partonMomX.first,  &m_brPartonMomX.first);
-      m_cInput -> SetBranchAddress("Parton3_MomY", &m_partonMomY.first,  &m_brPartonMomY.first);
-      m_cInput -> SetBranchAddress("Parton3_MomZ", &m_partonMomZ.first,  &m_brPartonMomZ.first);
-      m_cInput -> SetBranchAddress("Parton4_MomX", &m_partonMomX.second, &m_brPartonMomX.second);
-      m_cInput -> SetBranchAddress("Parton4_MomY", &m_partonMomY.second, &m_brPartonMomY.second);
-      m_cInput -> SetBranchAddress("Parton4_MomZ", &m_partonMomZ.second, &m_brPartonMomZ.second);
-      m_cInput -> SetBranchAddress("EvtSumParEne", &m_evtSumPar,         &m_brEvtSumPar);
-      m_cInput -> SetBranchAddress("CstID",        &m_cstID,             &m_brCstID);
-      m_cInput -> SetBranchAddress("CstEmbedID",   &m_cstEmbedID,        &m_brCstEmbedID);
+      m_reader -> Bind("Parton3_ID",   &m_partonID.first,    &m_brPartonID.first);
+      m_reader -> Bind("Parton4_ID",   &m_partonID.second,   &m_brPartonID.second);
+      m_reader -> Bind("Parton3_MomX", &m_partonMomX.first,  &m_brPartonMomX.first);
+      m_reader -> Bind("Parton3_MomY", &m_partonMomY.first,  &m_brPartonMomY.first);
+      m_reader -> Bind("Parton3_MomZ", &m_partonMomZ.first,  &m_brPartonMomZ.first);
+      m_reader -> Bind("Parton4_MomX", &m_partonMomX.second, &m_brPartonMomX.second);
+      m_reader -> Bind("Parton4_MomY", &m_partonMomY.second, &m_brPartonMomY.second);
+      m_reader -> Bind("Parton4_MomZ", &m_partonMomZ.second, &m_brPartonMomZ.second);
+      m_reader -> Bind("EvtSumParEne", &m_evtSumPar,         &m_brEvtSumPar);
+      m_reader -> Bind("CstID",        &m_cstID,             &m_brCstID);
+      m_reader -> Bind("CstEmbedID",   &m_cstEmbedID,        &m_brCstEmbedID);
     } else {
-      m_cInput -> SetBranchAddress("EvtNumTrks",    &m_evtNumTrks, &m_brEvtNumTrks);
-      m_cInput -> SetBranchAddress("EvtSumECalEne", &m_evtSumECal, &m_brEvtSumECal);
-      m_cInput -> SetBranchAddress("EvtSumHCalEne", &m_evtSumHCal, &m_brEvtSumHCal);
-      m_cInput -> SetBranchAddress("CstMatchID",    &m_cstMatchID, &m_brCstMatchID);
+      m_reader -> Bind("EvtNumTrks",    &m_evtNumTrks, &m_brEvtNumTrks);
+      m_reader -> Bind("EvtSumECalEne", &m_evtSumECal, &m_brEvtSumECal);
+      m_reader -> Bind("EvtSumHCalEne", &m_evtSumHCal, &m_brEvtSumHCal);
+      m_reader -> Bind("CstMatchID",    &m_cstMatchID, &m_brCstMatchID);
     }
 
     // set generic branch addresses
-    m_cInput -> SetBranchAddress("EvtVtxX",    &m_evtVtxX,    &m_brEvtVtxX);
-    m_cInput -> SetBranchAddress("EvtVtxY",    &m_evtVtxY,    &m_brEvtVtxY);
-    m_cInput -> SetBranchAddress("EvtVtxZ",    &m_evtVtxZ,    &m_brEvtVtxZ);
-    m_cInput -> SetBranchAddress("EvtNumJets", &m_evtNumJets, &m_brEvtNumJets);
-    m_cInput -> SetBranchAddress("JetNumCst",  &m_jetNumCst,  &m_brJetNumCst);
-    m_cInput -> SetBranchAddress("JetID",      &m_jetID,      &m_brJetID);
-    m_cInput -> SetBranchAddress("JetEnergy",  &m_jetEnergy,  &m_brJetEnergy);
-    m_cInput -> SetBranchAddress("JetPt",      &m_jetPt,      &m_brJetPt);
-    m_cInput -> SetBranchAddress("JetEta",     &m_jetEta,     &m_brJetEta);
-    m_cInput -> SetBranchAddress("JetPhi",     &m_jetPhi,     &m_brJetPhi);
-    m_cInput -> SetBranchAddress("JetArea",    &m_jetArea,    &m_brJetArea);
-    m_cInput -> SetBranchAddress("CstZ",       &m_cstZ,       &m_brCstZ);
-    m_cInput -> SetBranchAddress("CstDr",      &m_cstDr,      &m_brCstDr);
-    m_cInput -> SetBranchAddress("CstEnergy",  &m_cstEnergy,  &m_brCstEnergy);
-    m_cInput -> SetBranchAddress("CstJt",      &m_cstPt,      &m_brCstPt);
-    m_cInput -> SetBranchAddress("CstEta",     &m_cstEta,     &m_brCstEta);
-    m_cInput -> SetBranchAddress("CstPhi",     &m_cstPhi,     &m_brCstPhi);
+    m_reader -> Bind("EvtVtxX",    &m_evtVtxX,    &m_brEvtVtxX);
+    m_reader -> Bind("EvtVtxY",    &m_evtVtxY,    &m_brEvtVtxY);
+    m_reader -> Bind("EvtVtxZ",    &m_evtVtxZ,    &m_brEvtVtxZ);
+    m_reader -> Bind("EvtNumJets", &m_evtNumJets, &m_brEvtNumJets);
+    m_reader -> Bind("JetNumCst",  &m_jetNumCst,  &m_brJetNumCst);
+    m_reader -> Bind("JetID",      &m_jetID,      &m_brJetID);
+    m_reader -> Bind("JetEnergy",  &m_jetEnergy,  &m_brJetEnergy);
+    m_reader -> Bind("JetPt",      &m_jetPt,      &m_brJetPt);
+    m_reader -> Bind("JetEta",     &m_jetEta,     &m_brJetEta);
+    m_reader -> Bind("JetPhi",     &m_jetPhi,     &m_brJetPhi);
+    m_reader -> Bind("JetArea",    &m_jetArea,    &m_brJetArea);
+    m_reader -> Bind("CstZ",       &m_cstZ,       &m_brCstZ);
+    m_reader -> Bind("CstDr",      &m_cstDr,      &m_brCstDr);
+    m_reader -> Bind("CstEnergy",  &m_cstEnergy,  &m_brCstEnergy);
+    m_reader -> Bind("CstJt",      &m_cstPt,      &m_brCstPt);
+    m_reader -> Bind("CstEta",     &m_cstEta,     &m_brCstEta);
+    m_reader -> Bind("CstPhi",     &m_cstPhi,     &m_brCstPhi);
     cout << "    Initialized input chain." << endl;
 
     // exit routine
     return;
 
-  }  // end 'InitInput()'
+  }  // end 'InitTree()'
 
 
 
@@ -164,20 +162,39 @@ namespace SColdQcdCorrelatorAnalysis {
     for (size_t iDrEdge = 0; iDrEdge < nDrBinEdges; iDrEdge++) {
       drBinEdgeArray[iDrEdge] = drBinEdges.at(iDrEdge);
     }
-    hCstPtOneVsDr      = new TH2D("hCstPtOneVsDr",      "", m_nBinsDr, drBinEdgeArray, 200,  0.,   100.);
-    hCstPtTwoVsDr      = new TH2D("hCstPtTwoVsDr",      "", m_nBinsDr, drBinEdgeArray, 200,  0.,   100.);
-    hCstPtFracVsDr     = new TH2D("hCstPtFracVsDr",     "", m_nBinsDr, drBinEdgeArray, 500,  0.,   5.);
-    hCstPhiOneVsDr     = new TH2D("hCstPhiOneVsDr",     "", m_nBinsDr, drBinEdgeArray, 360, -3.15, 3.15);;
-    hCstPhiTwoVsDr     = new TH2D("hCstPhiTwoVsDr",     "", m_nBinsDr, drBinEdgeArray, 360, -3.15, 3.15);
-    hCstEtaOneVsDr     = new TH2D("hCstEtaOneVsDr",     "", m_nBinsDr, drBinEdgeArray, 400, -2.,   2.);
-    hCstEtaTwoVsDr     = new TH2D("hCstEtaTwoVsDr",     "", m_nBinsDr, drBinEdgeArray, 400, -2.,   2.);
-    hDeltaPhiOneVsDr   = new TH2D("hDeltaPhiOneVsDr",   "", m_nBinsDr, drBinEdgeArray, 720, -6.30, 6.30);
-    hDeltaPhiTwoVsDr   = new TH2D("hDeltaPhiTwoVsDr",   "", m_nBinsDr, drBinEdgeArray, 720, -6.30, 6.30);
-    hDeltaEtaOneVsDr   = new TH2D("hDeltaEtaOneVsDr",   "", m_nBinsDr, drBinEdgeArray, 800, -4.,   4.);
-    hDeltaEtaTwoVsDr   = new TH2D("hDeltaEtaTwoVsDr",   "", m_nBinsDr, drBinEdgeArray, 800, -4.,   4.);
-    hJetPtFracOneVsDr  = new TH2D("hJetPtFracOneVsDr",  "", m_nBinsDr, drBinEdgeArray, 500, 0.,    5.);
-    hJetPtFracTwoVsDr  = new TH2D("hJetPtFracTwoVsDr",  "", m_nBinsDr, drBinEdgeArray, 500, 0.,    5.);
-    hCstPairWeightVsDr = new TH2D("hCstPairWeightVsDr", "", m_nBinsDr, drBinEdgeArray, 100,  0.,   1.);
+
+    // histograms to book: address, name, and no. of
+    // bins and range of y axis
+    const vector<tuple<TH2**, string, int32_t, double, double>> vecHistDefs = {
+      {&hCstPtOneVsDr,      "hCstPtOneVsDr",      200,  0.,   100.},
+      {&hCstPtTwoVsDr,      "hCstPtTwoVsDr",      200,  0.,   100.},
+      {&hCstPtFracVsDr,     "hCstPtFracVsDr",     500,  0.,   5.},
+      {&hCstPhiOneVsDr,     "hCstPhiOneVsDr",     360, -3.15, 3.15},
+      {&hCstPhiTwoVsDr,     "hCstPhiTwoVsDr",     360, -3.15, 3.15},
+      {&hCstEtaOneVsDr,     "hCstEtaOneVsDr",     400, -2.,   2.},
+      {&hCstEtaTwoVsDr,     "hCstEtaTwoVsDr",     400, -2.,   2.},
+      {&hDeltaPhiOneVsDr,   "hDeltaPhiOneVsDr",   720, -6.30, 6.30},
+      {&hDeltaPhiTwoVsDr,   "hDeltaPhiTwoVsDr",   720, -6.30, 6.30},
+      {&hDeltaEtaOneVsDr,   "hDeltaEtaOneVsDr",   800, -4.,   4.},
+      {&hDeltaEtaTwoVsDr,   "hDeltaEtaTwoVsDr",   800, -4.,   4.},
+      {&hJetPtFracOneVsDr,  "hJetPtFracOneVsDr",  500,  0.,   5.},
+      {&hJetPtFracTwoVsDr,  "hJetPtFracTwoVsDr",  500,  0.,   5.},
+      {&hCstPairWeightVsDr, "hCstPairWeightVsDr", 100,  0.,   1.}
+    };
+
+    // check histograms against memory budget (there's
+    // no sparse option here, so going over only warns
+    // unless precision can be downgraded)
+    SHistBooker booker;
+    booker.SetPolicy(m_config.histPolicy);
+    for (const auto& def : vecHistDefs) {
+      booker.Plan(get<1>(def), (uint64_t) (m_nBinsDr + 2) * (get<2>(def) + 2));
+    }
+    booker.Resolve();
+
+    for (const auto& def : vecHistDefs) {
+      *get<0>(def) = booker.Make2D(get<1>(def), "", m_nBinsDr, drBinEdgeArray, get<2>(def), get<3>(def), get<4>(def));
+    }
     cout << "    Initialized histograms." << endl;
 
     // exit routine
@@ -204,6 +221,9 @@ namespace SColdQcdCorrelatorAnalysis {
     hJetPtFracOneVsDr  -> Write();
     hJetPtFracTwoVsDr  -> Write();
     hCstPairWeightVsDr -> Write();
+
+    // record which entries were processed
+    m_range.Write(m_outDir, m_nEvtsRead);
     return;
 
   }  // end 'SaveOutput()'
@@ -213,8 +233,12 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SCheckCstPairs::CloseInput() {
 
-    m_fInput -> cd();
-    m_fInput -> Close();
+    // deleting the reader and chain closes any
+    // open file
+    delete m_reader;
+    m_reader = NULL;
+    delete m_cInput;
+    m_cInput = NULL;
     return;
 
   }  // end 'CloseInput()'
@@ -223,30 +247,34 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SCheckCstPairs::DoDoubleCstLoop() {
 
-    // announce start of event loop
-    const uint64_t nEvts = m_cInput -> GetEntriesFast();
+    // select entries to process
+    m_range.Set(
+      m_reader -> GetEntries(),
+      m_config.firstEntry,
+      m_config.lastEntry,
+      m_config.iShard,
+      m_config.nShards
+    );
+    cout << "    Processing entries [" << m_range.first << ", " << m_range.last << ")"
+         << " (shard " << m_range.iShard << " of " << m_range.nShards << ")."
+         << endl;
 
-    // event loop
-    uint64_t nBytes = 0;
-    for (uint64_t iEvt = 0; iEvt < nEvts; iEvt++) {
+    // for reporting progress
+    SProgressMeter progress;
+    progress.SetInterval(m_config.progressInterval);
+    progress.Start(m_range.GetNEntries());
 
-      const uint64_t entry = Interfaces::LoadTree(m_cInput, iEvt, m_fCurrent);
-      if (entry < 0) break;
+    // event loop
+    for (int64_t iEvt = m_range.first; iEvt < m_range.last; iEvt++) {
 
-      const uint64_t bytes = Interfaces::GetEntry(m_cInput, iEvt);
+      const int64_t bytes = m_reader -> GetEntry(iEvt);
       if (bytes < 0) {
+        cerr << "WARNING: issue with event " << iEvt << "! Aborting event loop!" << endl;
         break;
-      } else {
-        nBytes += bytes;
       }
 
       // announce progress
-      const int64_t iProg = iEvt + 1;
-      if (iProg == nEvents) {
-        cout << "      Processing entry " << iEvt << "/" << nEvts << "..." << endl;
-      } else {
-        cout << "      Processing entry " << iEvt << "/" << nEvts << "...\r" << flush;
-      }
+      progress.Update(bytes);
 
       // jet loop
       uint64_t nJets = (int) m_evtNumJets;
@@ -311,6 +339,8 @@ namespace SColdQcdCorrelatorAnalysis {
         }  // end 1st cst loop
       }  // end jet loop
     }  // end event loop
+    progress.Finish();
+    m_nEvtsRead = progress.GetNDone();
     cout << "    Event loop finished!" << endl;
 
     // exit routine
@@ -15,6 +15,7 @@
 #define SCORRELATORQAMAKER_SCHECKCSTPAIRS_H
 
 // c++ utilities
+#include <tuple>
 #include <string>
 #include <vector>
 #include <utility>
@@ -22,6 +23,7 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TChain.h>
 #include <TBranch.h>
 // analysis utilities
@@ -30,6 +32,10 @@
 #include <scorrelatorutilities/Interfaces.h>
 // plugin definitions
 #include "SBaseQAPlugin.h"
+#include "SEntryRange.h"
+#include "SHistPolicy.h"
+#include "SInputReader.h"
+#include "SProgressMeter.h"
 #include "SCheckCstPairsConfig.h"
 
 // make common namespaces implicit
@@ -58,6 +64,7 @@ namespace SColdQcdCorrelatorAnalysis {
 
       // internal methods
       void InitInput();
+      void InitTree();
       void InitHists();
       void SaveOutput();
       void CloseInput();
@@ -65,25 +72,31 @@ namespace SColdQcdCorrelatorAnalysis {
       bool IsGoodJet();
       bool IsGoodCst();
 
-      // io members
-      TFile*  m_fInput = NULL;
-      TChain* m_cInput = NULL;
+      // input chain (lists the input files) and reader
+      // of tree or rntuple entries
+      TChain*       m_cInput = NULL;
+      SInputReader* m_reader = NULL;
+
+      // selected range of entries (incl. shard) and
+      // no. of entries read
+      SEntryRange m_range;
+      int64_t     m_nEvtsRead = 0;
 
       // output histograms
-      TH2D* hCstPtOneVsDr;
-      TH2D* hCstPtTwoVsDr;
-      TH2D* hCstPtFracVsDr;
-      TH2D* hCstPhiOneVsDr;
-      TH2D* hCstPhiTwoVsDr;
-      TH2D* hCstEtaOneVsDr;
-      TH2D* hCstEtaTwoVsDr;
-      TH2D* hDeltaPhiOneVsDr;
-      TH2D* hDeltaPhiTwoVsDr;
-      TH2D* hDeltaEtaOneVsDr;
-      TH2D* hDeltaEtaTwoVsDr;
-      TH2D* hJetPtFracOneVsDr;
-      TH2D* hJetPtFracTwoVsDr;
-      TH2D* hCstPairWeightVsDr;
+      TH2* hCstPtOneVsDr;
+      TH2* hCstPtTwoVsDr;
+      TH2* hCstPtFracVsDr;
+      TH2* hCstPhiOneVsDr;
+      TH2* hCstPhiTwoVsDr;
+      TH2* hCstEtaOneVsDr;
+      TH2* hCstEtaTwoVsDr;
+      TH2* hDeltaPhiOneVsDr;
+      TH2* hDeltaPhiTwoVsDr;
+      TH2* hDeltaEtaOneVsDr;
+      TH2* hDeltaEtaTwoVsDr;
+      TH2* hJetPtFracOneVsDr;
+      TH2* hJetPtFracTwoVsDr;
+      TH2* hCstPairWeightVsDr;
 
       // input truth tree addresses
       //   - FIXME swap out for utlity types when ready
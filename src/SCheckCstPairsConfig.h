@@ -14,6 +14,12 @@
 #ifndef SCORRELATORQAMAKER_SCHECKCSTPAIRSCONFIG_H
 #define SCORRELATORQAMAKER_SCHECKCSTPAIRSCONFIG_H
 
+// c++ utilities
+#include <string>
+#include <cstdint>
+// analysis utilities
+#include "SHistPolicy.h"
+
 // make common namespaces implicit
 using namespace std;
 
@@ -30,12 +36,34 @@ namespace SColdQcdCorrelatorAnalysis {
     string inChainName    {""};
     bool   isInChainTruth {true};
 
+    // input format: "ttree", "rntuple", or "auto" to
+    // pick it from the input; rntuple pages are
+    // decompressed in parallel over nUnzipThreads
+    // threads (0 to decompress in the reading thread)
+    string   inFormat      {"auto"};
+    uint16_t nUnzipThreads {0};
+
+    // entries to process: [firstEntry, lastEntry) is
+    // split into nShards, of which shard iShard is
+    // processed (lastEntry < 0 means through the end)
+    int64_t  firstEntry {0};
+    int64_t  lastEntry  {-1};
+    uint32_t iShard     {0};
+    uint32_t nShards    {1};
+
+    // seconds between progress updates
+    double progressInterval {10.};
+
     // jet and cst acceptances
-    ptJetMin  {0.2};
-    etaJetMax {0.7};
-    drCstMax  {10.};
-    eCstMin   {0.2};
-    eCstMax   {100.};
+    double ptJetMin  {0.2};
+    double etaJetMax {0.7};
+    double drCstMax  {10.};
+    double eCstMin   {0.2};
+    double eCstMax   {100.};
+
+    // histogram storage: precision of each family of
+    // histograms and total memory budget
+    SHistPolicy histPolicy {};
 
   };  // end SCheckCstPairsConfig
 
@@ -0,0 +1,278 @@
+// ----------------------------------------------------------------------------
+// 'SCheckpoint.h'
+// Derek Anderson
+// 04.15.2024
+//
+// Checkpointing for standalone plugins: a snapshot of
+// a plugin's state (histograms, arrays of counts, and
+// where to pick up the event loop) is copied in the
+// event loop and then written to a side file by a
+// background thread, so long jobs that get preempted
+// can resume from the last checkpoint. The snapshot
+// buffers are allocated on the first checkpoint and
+// reused after that, so later checkpoints only copy
+// bin contents.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SCHECKPOINT_H
+#define SCORRELATORQAMAKER_SCHECKPOINT_H
+
+// c++ utilities
+#include <atomic>
+#include <tuple>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <iostream>
+// root libraries
+#include <TH1.h>
+#include <TFile.h>
+#include <TNamed.h>
+#include <TArrayD.h>
+#include <TArrayF.h>
+#include <TArrayI.h>
+#include <TObject.h>
+#include <TDirectory.h>
+#include <TParameter.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SCheckpointState definition ----------------------------------------------
+
+  struct SCheckpointState {
+
+    // where the event loop was
+    int64_t firstEntry = 0;
+    int64_t lastEntry  = 0;
+    int64_t nextEntry  = 0;
+    int64_t nEvtsRead  = 0;
+    int64_t nBytesRead = 0;
+
+    // description of what the state holds (e.g. cuts
+    // and binning), checked before resuming
+    string fingerprint = "";
+
+    // (directory, object) and (directory, name, array)
+    // to save: objects are owned by the state, and only
+    // the first nObjects/nArrays are in the current
+    // snapshot (the rest are spare buffers)
+    vector<pair<string, TObject*>>               vecObjects;
+    vector<tuple<string, string, vector<double>>> vecArrays;
+    size_t                                        nObjects = 0;
+    size_t                                        nArrays  = 0;
+
+    ~SCheckpointState() {
+      for (auto& object : vecObjects) {
+        delete object.second;
+      }
+    }
+
+    // start a new snapshot, reusing the buffers of the
+    // last one (things must be added in the same order
+    // every time for the buffers to line up)
+    void Begin() {
+      nObjects = 0;
+      nArrays  = 0;
+    }
+
+    // copies bins into the buffer in this slot if it
+    // matches, and clones the histogram otherwise
+    void AddHist(const string dir, const TH1* hist) {
+
+      if (nObjects < vecObjects.size()) {
+        TH1* buffer = (TH1*) vecObjects[nObjects].second;
+        if (CopyBins(hist, buffer)) {
+          vecObjects[nObjects].first = dir;
+          ++nObjects;
+          return;
+        }
+      }
+
+      TH1* clone = (TH1*) hist -> Clone();
+      clone -> SetDirectory(NULL);
+      AddObject(dir, clone);
+      return;
+
+    }  // end 'AddHist(string, TH1*)'
+
+    // takes ownership of object, replacing whatever is
+    // in this slot
+    void AddObject(const string dir, TObject* object) {
+
+      if (nObjects < vecObjects.size()) {
+        delete vecObjects[nObjects].second;
+        vecObjects[nObjects] = make_pair(dir, object);
+      } else {
+        vecObjects.push_back( make_pair(dir, object) );
+      }
+      ++nObjects;
+      return;
+
+    }  // end 'AddObject(string, TObject*)'
+
+    template <typename T> void AddArray(const string dir, const string name, const vector<T>& array) {
+
+      if (nArrays < vecArrays.size()) {
+        get<0>(vecArrays[nArrays]) = dir;
+        get<1>(vecArrays[nArrays]) = name;
+        get<2>(vecArrays[nArrays]).assign(array.begin(), array.end());
+      } else {
+        vecArrays.push_back( make_tuple(dir, name, vector<double>(array.begin(), array.end())) );
+      }
+      ++nArrays;
+      return;
+
+    }  // end 'AddArray(string, string, vector<T>&)'
+
+    void Write(const string fileName) const {
+
+      // write to temporary file first so that a job
+      // killed mid-write keeps the previous checkpoint
+      const string tmpName = fileName + ".tmp";
+      TFile file(tmpName.data(), "recreate");
+      const vector<pair<string, int64_t>> vecPars = {
+        {"firstEntry", firstEntry},
+        {"lastEntry",  lastEntry},
+        {"nextEntry",  nextEntry},
+        {"nEvtsRead",  nEvtsRead},
+        {"nBytesRead", nBytesRead}
+      };
+      for (const auto& [name, value] : vecPars) {
+        TParameter<Long64_t> par(name.data(), value);
+        file.WriteTObject(&par);
+      }
+      TNamed print("fingerprint", fingerprint.data());
+      file.WriteTObject(&print);
+      for (size_t iObject = 0; iObject < nObjects; iObject++) {
+        GetDir(file, vecObjects[iObject].first) -> WriteTObject(vecObjects[iObject].second);
+      }
+      for (size_t iArray = 0; iArray < nArrays; iArray++) {
+        const auto& [dir, name, array] = vecArrays[iArray];
+        GetDir(file, dir) -> WriteObject(&array, name.data());
+      }
+      file.Close();
+
+      // then swap it in
+      if (rename(tmpName.data(), fileName.data()) != 0) {
+        cerr << "WARNING: couldn't move checkpoint into place: \"" << fileName << "\"!" << endl;
+      }
+      return;
+
+    }  // end 'Write(string)'
+
+    static TDirectory* GetDir(TFile& file, const string dir) {
+      TDirectory* found = file.GetDirectory(dir.data());
+      return found ? found : file.mkdir(dir.data());
+    }
+
+    // copy bin contents, sumw2 and stats between two
+    // histograms of the same type and binning (returns
+    // false if they don't match)
+    static bool CopyBins(const TH1* from, TH1* to) {
+
+      const bool isCopied = (
+        CopyArray<TArrayD>(from, to) ||
+        CopyArray<TArrayF>(from, to) ||
+        CopyArray<TArrayI>(from, to)
+      );
+      if (!isCopied) return false;
+
+      const TArrayD* fromSumw2 = from -> GetSumw2();
+      TArrayD*       toSumw2   = to -> GetSumw2();
+      if (fromSumw2 -> GetSize() != toSumw2 -> GetSize()) return false;
+      if (fromSumw2 -> GetSize() > 0) {
+        memcpy(toSumw2 -> GetArray(), fromSumw2 -> GetArray(), fromSumw2 -> GetSize() * sizeof(double));
+      }
+
+      double stats[TH1::kNstat];
+      from -> GetStats(stats);
+      to   -> PutStats(stats);
+      to   -> SetEntries(from -> GetEntries());
+      return true;
+
+    }  // end 'CopyBins(TH1*, TH1*)'
+
+    template <typename A> static bool CopyArray(const TH1* from, TH1* to) {
+
+      const A* fromArray = dynamic_cast<const A*>(from);
+      A*       toArray   = dynamic_cast<A*>(to);
+      if (!fromArray || !toArray || (fromArray -> GetSize() != toArray -> GetSize())) return false;
+
+      memcpy(toArray -> GetArray(), fromArray -> GetArray(), fromArray -> GetSize() * sizeof(*fromArray -> GetArray()));
+      return true;
+
+    }  // end 'CopyArray(TH1*, TH1*)'
+
+    static bool ReadArray(TDirectory* dir, const string name, vector<double>& array) {
+
+      vector<double>* read = NULL;
+      dir -> GetObject(name.data(), read);
+      if (!read || (read -> size() != array.size())) return false;
+
+      array = *read;
+      delete read;
+      return true;
+
+    }  // end 'ReadArray(TDirectory*, string, vector<double>&)'
+
+  };  // end SCheckpointState
+
+
+
+  // SCheckpointWriter definition ---------------------------------------------
+
+  class SCheckpointWriter {
+
+    public:
+
+      // ctor/dtor
+      SCheckpointWriter()  {};
+      ~SCheckpointWriter() {Wait();}
+
+      // a new checkpoint is only started once the
+      // previous one is done
+      bool IsBusy() const {return m_isBusy;}
+
+      // snapshot to fill before starting a checkpoint:
+      // only touch it while the writer isn't busy
+      SCheckpointState& GetState() {return m_state;}
+
+      void Start(const string fileName) {
+
+        Wait();
+        m_isBusy = true;
+        m_thread = thread(
+          [this, fileName]() {
+            m_state.Write(fileName);
+            m_isBusy = false;
+          }
+        );
+        return;
+
+      }  // end 'Start(string)'
+
+      void Wait() {
+        if (m_thread.joinable()) m_thread.join();
+      }
+
+    private:
+
+      SCheckpointState m_state;
+      thread           m_thread;
+      atomic<bool>     m_isBusy {false};
+
+  };  // end SCheckpointWriter
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,88 @@
+// ----------------------------------------------------------------------------
+// 'SEntryRange.h'
+// Derek Anderson
+// 04.05.2024
+//
+// Range of input entries for a standalone plugin to
+// process: an optional first/last entry, split into
+// "shard k of n" so that several jobs can process
+// disjoint slices of the same input.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SENTRYRANGE_H
+#define SCORRELATORQAMAKER_SENTRYRANGE_H
+
+// c++ utilities
+#include <algorithm>
+#include <iostream>
+// root libraries
+#include <TDirectory.h>
+#include <TParameter.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SEntryRange definition ---------------------------------------------------
+
+  struct SEntryRange {
+
+    // range is [first, last)
+    int64_t  first   = 0;
+    int64_t  last    = 0;
+    uint32_t iShard  = 0;
+    uint32_t nShards = 1;
+
+    void Set(
+      const int64_t nEntries,
+      const int64_t firstEntry,
+      const int64_t lastEntry,
+      const uint32_t shard,
+      const uint32_t nShard
+    ) {
+
+      // clamp requested range (last < 0 means through
+      // the end of the input)
+      const int64_t start = min(max(firstEntry, (int64_t) 0), nEntries);
+      const int64_t stop  = ((lastEntry < 0) || (lastEntry > nEntries)) ? nEntries : max(lastEntry, start);
+
+      // then pick out this shard
+      nShards = max(nShard, (uint32_t) 1);
+      iShard  = min(shard, nShards - 1);
+      if (shard >= nShards) {
+        cerr << "WARNING: shard " << shard << " out of range for " << nShards << " shards! Using last shard." << endl;
+      }
+
+      const int64_t nRange = stop - start;
+      first = start + ((nRange * iShard) / nShards);
+      last  = start + ((nRange * (iShard + 1)) / nShards);
+      return;
+
+    }  // end 'Set(int64_t, int64_t, int64_t, uint32_t, uint32_t)'
+
+    int64_t GetNEntries() const {return last - first;}
+
+    void Write(TDirectory* dir, const int64_t nRead) const {
+
+      // record range and no. of entries read
+      // alongside the output
+      dir -> cd();
+      TParameter<Long64_t>("iShard",       iShard).Write();
+      TParameter<Long64_t>("nShards",      nShards).Write();
+      TParameter<Long64_t>("firstEntry",   first).Write();
+      TParameter<Long64_t>("lastEntry",    last).Write();
+      TParameter<Long64_t>("nEntriesRead", nRead).Write();
+      return;
+
+    }  // end 'Write(TDirectory*, int64_t)'
+
+  };  // end SEntryRange
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
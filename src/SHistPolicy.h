@@ -0,0 +1,281 @@
+// ----------------------------------------------------------------------------
+// 'SHistPolicy.h'
+// Derek Anderson
+// 04.18.2024
+//
+// Storage policy for QA histograms: each family of
+// histograms (matched by name) is booked with integer,
+// float or double bins, and the total is checked
+// against a memory budget before anything is booked.
+// If the budget would be exceeded, the booker either
+// warns, steps families down in precision until they
+// fit, or leaves it to the caller to switch to sparse
+// storage.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SHISTPOLICY_H
+#define SCORRELATORQAMAKER_SHISTPOLICY_H
+
+// c++ utilities
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <fnmatch.h>
+#include <iostream>
+// root libraries
+#include <TH1.h>
+#include <TH2.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SHistPolicy definition ---------------------------------------------------
+
+  struct SHistPolicy {
+
+    // bin storage: integer counts (no sumw2, so only
+    // for unweighted fills), float, or double
+    enum Precision {Int, Float, Double};
+
+    // what to do if the budget would be exceeded
+    // (Sparse is left to the caller: sparse storage
+    // grows with the no. of bins filled, so it isn't
+    // held to the budget)
+    enum Action {Warn, Downgrade, Sparse};
+
+    // precision of each family as (glob on histogram
+    // name, precision): first match wins, and anything
+    // unmatched uses defPrecision
+    vector<pair<string, Precision>> vecFamilies  {};
+    Precision                       defPrecision {Double};
+
+    // total budget in MB (0 for no cap)
+    double budgetMB   {0.};
+    Action overBudget {Warn};
+
+  };  // end SHistPolicy
+
+
+
+  // SHistBooker definition ---------------------------------------------------
+
+  class SHistBooker {
+
+    public:
+
+      // ctor/dtor
+      SHistBooker()  {};
+      ~SHistBooker() {};
+
+      void SetPolicy(const SHistPolicy& policy) {
+
+        m_policy = policy;
+        m_vecPrecision.assign(m_policy.vecFamilies.size() + 1, m_policy.defPrecision);
+        for (size_t iFam = 0; iFam < m_policy.vecFamilies.size(); iFam++) {
+          m_vecPrecision[iFam] = m_policy.vecFamilies[iFam].second;
+        }
+        m_vecCells.assign(m_vecPrecision.size(), 0);
+        return;
+
+      }  // end 'SetPolicy(SHistPolicy&)'
+
+      // 1st pass: declare each histogram to be booked
+      // and its no. of cells (incl. under/overflow)
+      void Plan(const string name, const uint64_t nCells) {
+        m_vecCells[GetFamily(name)] += nCells;
+      }
+
+      // 2nd pass: check planned histograms against the
+      // budget, stepping down the largest family first
+      // if downgrading; returns whether they fit
+      bool Resolve() {
+
+        if (m_policy.budgetMB <= 0.) return true;
+
+        const uint64_t budget = (uint64_t) (m_policy.budgetMB * 1.0e6);
+        while ((GetBytes() > budget) && (m_policy.overBudget == SHistPolicy::Downgrade)) {
+
+          int64_t  iLargest = -1;
+          uint64_t nLargest = 0;
+          for (size_t iFam = 0; iFam < m_vecCells.size(); iFam++) {
+            const uint64_t nBytes = m_vecCells[iFam] * GetBytesPerCell(m_vecPrecision[iFam]);
+            if ((m_vecPrecision[iFam] != SHistPolicy::Int) && (nBytes > nLargest)) {
+              iLargest = iFam;
+              nLargest = nBytes;
+            }
+          }
+          if (iLargest < 0) break;
+
+          m_vecPrecision[iLargest] = (SHistPolicy::Precision) (m_vecPrecision[iLargest] - 1);
+          cout << "    Histogram budget: downgrading family \"" << GetFamilyName(iLargest) << "\""
+               << " to " << GetPrecisionName(m_vecPrecision[iLargest]) << "."
+               << endl;
+        }
+
+        const bool isInBudget = (GetBytes() <= budget);
+        if (!isInBudget) {
+          cerr << "WARNING: histograms need ~" << (double) GetBytes() / 1.0e6 << " MB,"
+               << " over the budget of " << m_policy.budgetMB << " MB!"
+               << endl;
+        }
+        return isInBudget;
+
+      }  // end 'Resolve()'
+
+      // total memory of planned histograms
+      uint64_t GetBytes() const {
+
+        uint64_t nBytes = 0;
+        for (size_t iFam = 0; iFam < m_vecCells.size(); iFam++) {
+          nBytes += m_vecCells[iFam] * GetBytesPerCell(m_vecPrecision[iFam]);
+        }
+        return nBytes;
+
+      }  // end 'GetBytes()'
+
+      TH1* Make1D(const string name, const string title, const int32_t nX, const double xLo, const double xHi) const {
+
+        TH1* hist = NULL;
+        switch (GetPrecision(name)) {
+          case SHistPolicy::Int:
+            hist = new TH1I(name.data(), title.data(), nX, xLo, xHi);
+            break;
+          case SHistPolicy::Float:
+            hist = new TH1F(name.data(), title.data(), nX, xLo, xHi);
+            break;
+          default:
+            hist = new TH1D(name.data(), title.data(), nX, xLo, xHi);
+            break;
+        }
+        return Finish(hist, name);
+
+      }  // end 'Make1D(string, string, int32_t, double, double)'
+
+      TH2* Make2D(
+        const string name,
+        const string title,
+        const int32_t nX,
+        const double xLo,
+        const double xHi,
+        const int32_t nY,
+        const double yLo,
+        const double yHi
+      ) const {
+
+        TH2* hist = NULL;
+        switch (GetPrecision(name)) {
+          case SHistPolicy::Int:
+            hist = new TH2I(name.data(), title.data(), nX, xLo, xHi, nY, yLo, yHi);
+            break;
+          case SHistPolicy::Float:
+            hist = new TH2F(name.data(), title.data(), nX, xLo, xHi, nY, yLo, yHi);
+            break;
+          default:
+            hist = new TH2D(name.data(), title.data(), nX, xLo, xHi, nY, yLo, yHi);
+            break;
+        }
+        return Finish(hist, name);
+
+      }  // end 'Make2D(string, string, int32_t, double, double, int32_t, double, double)'
+
+      TH2* Make2D(
+        const string name,
+        const string title,
+        const int32_t nX,
+        const double* xEdges,
+        const int32_t nY,
+        const double yLo,
+        const double yHi
+      ) const {
+
+        TH2* hist = NULL;
+        switch (GetPrecision(name)) {
+          case SHistPolicy::Int:
+            hist = new TH2I(name.data(), title.data(), nX, xEdges, nY, yLo, yHi);
+            break;
+          case SHistPolicy::Float:
+            hist = new TH2F(name.data(), title.data(), nX, xEdges, nY, yLo, yHi);
+            break;
+          default:
+            hist = new TH2D(name.data(), title.data(), nX, xEdges, nY, yLo, yHi);
+            break;
+        }
+        return Finish(hist, name);
+
+      }  // end 'Make2D(string, string, int32_t, double*, int32_t, double, double)'
+
+      SHistPolicy::Precision GetPrecision(const string name) const {
+        return m_vecPrecision[GetFamily(name)];
+      }
+
+      // no. of bytes per cell for a precision (sumw2
+      // is kept in doubles if on by default)
+      static uint64_t GetBytesPerCell(const SHistPolicy::Precision precision) {
+
+        const uint64_t nSumw2 = TH1::GetDefaultSumw2() ? sizeof(double) : 0;
+        switch (precision) {
+          case SHistPolicy::Int:
+            return sizeof(int32_t);
+          case SHistPolicy::Float:
+            return sizeof(float) + nSumw2;
+          default:
+            return sizeof(double) + nSumw2;
+        }
+
+      }  // end 'GetBytesPerCell(SHistPolicy::Precision)'
+
+      static string GetPrecisionName(const SHistPolicy::Precision precision) {
+
+        switch (precision) {
+          case SHistPolicy::Int:
+            return "int";
+          case SHistPolicy::Float:
+            return "float";
+          default:
+            return "double";
+        }
+
+      }  // end 'GetPrecisionName(SHistPolicy::Precision)'
+
+    private:
+
+      // index of family a histogram belongs to (last
+      // index is the default family)
+      size_t GetFamily(const string name) const {
+
+        for (size_t iFam = 0; iFam < m_policy.vecFamilies.size(); iFam++) {
+          if (fnmatch(m_policy.vecFamilies[iFam].first.data(), name.data(), 0) == 0) return iFam;
+        }
+        return m_policy.vecFamilies.size();
+
+      }  // end 'GetFamily(string)'
+
+      string GetFamilyName(const size_t iFam) const {
+        return (iFam < m_policy.vecFamilies.size()) ? m_policy.vecFamilies[iFam].first : "(default)";
+      }
+
+      // integer counts carry no sumw2: errors are then
+      // sqrt(content)
+      template <typename T> T* Finish(T* hist, const string name) const {
+        if (GetPrecision(name) == SHistPolicy::Int) hist -> Sumw2(false);
+        return hist;
+      }
+
+      // policy, and resolved precision and planned
+      // no. of cells of each family
+      SHistPolicy                    m_policy;
+      vector<SHistPolicy::Precision> m_vecPrecision = {SHistPolicy::Double};
+      vector<uint64_t>               m_vecCells     = {0};
+
+  };  // end SHistBooker
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,303 @@
+// ----------------------------------------------------------------------------
+// 'SInputReader.h'
+// Derek Anderson
+// 04.16.2024
+//
+// Reader for the input of standalone plugins: a plugin
+// binds the fields it uses to its members, and then
+// entries are read either from a TTree/TChain or from
+// an RNTuple (one per file). The format can be set or
+// picked from the first input file. RNTuple fields are
+// read through views, so only the columns of active
+// fields are read.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SINPUTREADER_H
+#define SCORRELATORQAMAKER_SINPUTREADER_H
+
+// c++ utilities
+#include <memory>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <fnmatch.h>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+// root libraries
+#include <TKey.h>
+#include <TFile.h>
+#include <TChain.h>
+#include <TBranch.h>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleView.hxx>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SInputReader definition --------------------------------------------------
+
+  class SInputReader {
+
+    public:
+
+      // input formats
+      enum class Format {Tree, NTuple};
+
+      // ctor/dtor
+      SInputReader()  {};
+      ~SInputReader() {};
+
+      // getters
+      Format  GetFormat()                       const {return m_format;}
+      bool    IsNTuple()                        const {return (m_format == Format::NTuple);}
+      size_t  GetNFiles()                       const {return m_vecFiles.size();}
+      string  GetFile(const size_t iFile)       const {return m_vecFiles[iFile];}
+      int64_t GetFileOffset(const size_t iFile) const {return m_vecOffsets[iFile];}
+      int64_t GetEntries()                      const {return m_vecOffsets.back();}
+
+      void Open(TChain* chain, const string format) {
+
+        // chain holds the list of input files and the
+        // name of the tree/rntuple in each
+        m_chain = chain;
+        m_name  = chain -> GetName();
+        m_vecFiles.clear();
+        for (int32_t iFile = 0; iFile < chain -> GetListOfFiles() -> GetEntries(); iFile++) {
+          m_vecFiles.push_back(chain -> GetListOfFiles() -> At(iFile) -> GetTitle());
+        }
+
+        // pick format
+        if (format == "rntuple") {
+          m_format = Format::NTuple;
+        } else if ((format == "ttree") || m_vecFiles.empty()) {
+          m_format = Format::Tree;
+        } else {
+          if (format != "auto") {
+            cerr << "WARNING: unknown input format \"" << format << "\", detecting it from input." << endl;
+          }
+          m_format = DetectFormat(m_vecFiles.front());
+        }
+
+        // get no. of entries in each file (for a chain
+        // this will open each file once)
+        m_vecOffsets.assign(1, 0);
+        if (IsNTuple()) {
+          for (const string& file : m_vecFiles) {
+            auto ntuple = ROOT::Experimental::RNTupleReader::Open(m_name, file);
+            m_vecOffsets.push_back(m_vecOffsets.back() + (int64_t) ntuple -> GetNEntries());
+          }
+        } else {
+          m_chain -> SetMakeClass(1);
+          m_chain -> GetEntries();
+
+          const Long64_t* offsets = m_chain -> GetTreeOffset();
+          for (int32_t iTree = 1; iTree <= m_chain -> GetNtrees(); iTree++) {
+            m_vecOffsets.push_back(offsets[iTree]);
+          }
+        }
+        return;
+
+      }  // end 'Open(TChain*, string)'
+
+      // bind a field to a value: for an rntuple the
+      // value is copied in after each entry is read
+      template <typename T> void Bind(const string field, T* address, TBranch** branch = NULL) {
+
+        if (!IsNTuple()) {
+          m_chain -> SetBranchAddress(field.data(), address, branch);
+          return;
+        }
+
+        auto view = make_shared<unique_ptr<ROOT::Experimental::RNTupleView<T>>>();
+        m_vecBindings.push_back({
+          field,
+          [field, view](ROOT::Experimental::RNTupleReader* reader) {
+            if (reader) {
+              *view = make_unique<ROOT::Experimental::RNTupleView<T>>(reader -> GetView<T>(field));
+            } else {
+              view -> reset();
+            }
+          },
+          [address, view](const uint64_t entry) {
+            if (*view) *address = (**view)(entry);
+          }
+        });
+        return;
+
+      }  // end 'Bind(string, T*, TBranch**)'
+
+      // bind a field to a pointer: for an rntuple the
+      // pointer is aimed at the view's copy, or at an
+      // empty object if the field isn't read
+      template <typename T> void Bind(const string field, T** address, TBranch** branch = NULL) {
+
+        if (!IsNTuple()) {
+          m_chain -> SetBranchAddress(field.data(), address, branch);
+          return;
+        }
+
+        auto view  = make_shared<unique_ptr<ROOT::Experimental::RNTupleView<T>>>();
+        auto empty = make_shared<T>();
+        m_vecBindings.push_back({
+          field,
+          [field, address, view, empty](ROOT::Experimental::RNTupleReader* reader) {
+            if (reader) {
+              *view = make_unique<ROOT::Experimental::RNTupleView<T>>(reader -> GetView<T>(field));
+            } else {
+              view -> reset();
+            }
+            *address = empty.get();
+          },
+          [address, view](const uint64_t entry) {
+            if (*view) *address = const_cast<T*>(&(**view)(entry));
+          }
+        });
+        return;
+
+      }  // end 'Bind(string, T**, TBranch**)'
+
+      // only read fields matching one of the given
+      // patterns (empty to read all bound fields)
+      void SetActive(const vector<string>& vecActive) {
+
+        m_vecActive = vecActive;
+        if (IsNTuple() || vecActive.empty()) return;
+
+        m_chain -> SetBranchStatus("*", 0);
+        for (const string& branch : vecActive) {
+          m_chain -> SetBranchStatus(branch.data(), 1);
+        }
+        return;
+
+      }  // end 'SetActive(vector<string>&)'
+
+      // returns no. of bytes read for a tree, 0 for an
+      // rntuple (bytes aren't tracked there), and -1 if
+      // the entry couldn't be read
+      int64_t GetEntry(const int64_t entry) {
+
+        if (!IsNTuple()) {
+          return m_chain -> GetEntry(entry);
+        }
+        if ((entry < 0) || (entry >= GetEntries())) return -1;
+
+        // switch files if needed
+        const int64_t iFile = (upper_bound(m_vecOffsets.begin(), m_vecOffsets.end(), entry) - m_vecOffsets.begin()) - 1;
+        if (iFile != m_iFile) {
+          OpenFile(iFile);
+        }
+
+        const uint64_t local = entry - m_vecOffsets[iFile];
+        for (const Binding& binding : m_vecBindings) {
+          binding.update(local);
+        }
+        return 0;
+
+      }  // end 'GetEntry(int64_t)'
+
+      void Close() {
+
+        for (Binding& binding : m_vecBindings) {
+          binding.make(NULL);
+        }
+        m_ntuple.reset();
+        m_iFile = -1;
+        return;
+
+      }  // end 'Close()'
+
+    private:
+
+      // a bound rntuple field: make creates a view of
+      // the field in a reader (or unbinds it if there's
+      // no reader) and update reads an entry through it
+      struct Binding {
+        string                                                    field;
+        function<void(ROOT::Experimental::RNTupleReader* reader)> make;
+        function<void(const uint64_t entry)>                      update;
+      };
+
+      Format DetectFormat(const string fileName) const {
+
+        // anything that isn't an rntuple is left
+        // to the chain
+        TFile* file = TFile::Open(fileName.data(), "read");
+        if (!file) return Format::Tree;
+
+        TKey*      key      = file -> GetKey(m_name.data());
+        const bool isNTuple = key && (string(key -> GetClassName()).find("RNTuple") != string::npos);
+        file -> Close();
+        delete file;
+
+        cout << "    Detected " << (isNTuple ? "RNTuple" : "TTree") << " input." << endl;
+        return isNTuple ? Format::NTuple : Format::Tree;
+
+      }  // end 'DetectFormat(string)'
+
+      bool IsActive(const string field) const {
+
+        if (m_vecActive.empty()) return true;
+        for (const string& pattern : m_vecActive) {
+          if (fnmatch(pattern.data(), field.data(), 0) == 0) return true;
+        }
+        return false;
+
+      }  // end 'IsActive(string)'
+
+      void OpenFile(const int64_t iFile) {
+
+        // drop views into the previous file first
+        for (Binding& binding : m_vecBindings) {
+          binding.make(NULL);
+        }
+
+        // views only read the columns of their field, so
+        // the file is opened once without a model; pages
+        // are decompressed in parallel if implicit
+        // multithreading is on
+        m_ntuple = ROOT::Experimental::RNTupleReader::Open(m_name, m_vecFiles[iFile]);
+        m_iFile  = iFile;
+        for (Binding& binding : m_vecBindings) {
+          const bool isActive = IsActive(binding.field);
+          const bool isFound  = (m_ntuple -> GetDescriptor().FindFieldId(binding.field) != ROOT::Experimental::kInvalidDescriptorId);
+          if (isActive && !isFound) {
+            cerr << "PANIC: no field \"" << binding.field << "\" in \"" << m_vecFiles[iFile] << "\"!\n" << endl;
+            assert(isFound);
+          }
+          binding.make((isActive && isFound) ? m_ntuple.get() : NULL);
+        }
+        return;
+
+      }  // end 'OpenFile(int64_t)'
+
+      // input format and name of tree/rntuple
+      Format m_format = Format::Tree;
+      string m_name   = "";
+
+      // input files and entry offset of each (last
+      // element is the total no. of entries)
+      vector<string>  m_vecFiles;
+      vector<int64_t> m_vecOffsets = {0};
+
+      // tree input (not owned)
+      TChain* m_chain = NULL;
+
+      // rntuple input: reader of current file and
+      // fields bound to it
+      int64_t                                       m_iFile = -1;
+      unique_ptr<ROOT::Experimental::RNTupleReader> m_ntuple;
+      vector<Binding>                               m_vecBindings;
+      vector<string>                                m_vecActive;
+
+  };  // end SInputReader
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
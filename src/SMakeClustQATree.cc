@@ -26,14 +26,62 @@ namespace SColdQcdCorrelatorAnalysis {
 
   int SMakeClustQATree::Init(PHCompositeNode* topNode) {
 
+    // track-cluster matches are only saved in the
+    // output tree, so skip matching without it
+    if (m_config.doTrkMatch && !m_config.doTree) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::Init(PHCompositeNode*): no output tree, turning off track-cluster matching." << endl;
+      m_config.doTrkMatch = false;
+    }
+
+    // same for sparse towers
+    if (m_config.doTowerQA && !m_config.doTree) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::Init(PHCompositeNode*): no output tree, turning off tower QA." << endl;
+      m_config.doTowerQA = false;
+    }
+
     InitOutput();
-    InitTree();
+    if (m_config.doTree) {
+      InitTree();
+    }
+    if (m_config.doFlatTree) {
+      InitFlatTree();
+    }
+
+    // set up cluster index if matching tracks
+    if (m_config.doTrkMatch) {
+      m_emCalIndex.SetBinning(m_config.nIndexEtaBins, m_config.nIndexPhiBins, m_config.rIndexEta);
+    }
     return Fun4AllReturnCodes::EVENT_OK;
 
   }  // end 'Init(PHCompositeNode*)'
 
 
 
+  int SMakeClustQATree::InitRun(PHCompositeNode* topNode) {
+
+    // book histograms for this run if needed (inputs
+    // without a run no., e.g. simulation, go in run 0)
+    if (m_config.doHists) {
+      recoConsts* consts = recoConsts::instance();
+      const bool  hasRun = consts -> FlagExist("RUNNUMBER");
+      if (!hasRun) {
+        cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitRun(PHCompositeNode*) WARNING: no RUNNUMBER flag, filling histograms for run 0." << endl;
+      }
+      InitRunHists( hasRun ? consts -> get_IntFlag("RUNNUMBER") : 0 );
+    }
+
+    // grab tower geometries if needed
+    if (m_config.doTowerQA) {
+      InitTowerGeom(topNode, "TOWERGEOM_CEMC");
+      InitTowerGeom(topNode, "TOWERGEOM_HCALIN");
+      InitTowerGeom(topNode, "TOWERGEOM_HCALOUT");
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+
+  }  // end 'InitRun(PHCompositeNode*)'
+
+
+
   int SMakeClustQATree::process_event(PHCompositeNode* topNode) {
 
     // make sure output container is empty
@@ -49,8 +97,25 @@ namespace SColdQcdCorrelatorAnalysis {
     DoClustLoop(topNode, "CLUSTER_HCALIN");
     DoClustLoop(topNode, "CLUSTER_HCALOUT");
 
-    // fill output tree and reset
-    m_tClustQA -> Fill();
+    // grab tower info if needed
+    if (m_config.doTowerQA) {
+      DoTowerLoop(topNode, "TOWER_CALIB_CEMC");
+      DoTowerLoop(topNode, "TOWER_CALIB_HCALIN");
+      DoTowerLoop(topNode, "TOWER_CALIB_HCALOUT");
+    }
+
+    // if needed, match tracks to emcal clusters
+    if (m_config.doTrkMatch) {
+      DoTrackMatching(topNode);
+    }
+
+    // fill output tree
+    if (m_config.doTree) {
+      m_tClustQA -> Fill();
+    }
+    if (m_config.doFlatTree) {
+      FillFlatTree();
+    }
     return Fun4AllReturnCodes::EVENT_OK;
 
   }  // end 'process_event(PHCompositeNode* topNode)'
@@ -83,26 +148,248 @@ namespace SColdQcdCorrelatorAnalysis {
     m_tClustQA -> Branch("EMCalInfo", "vector<Types::ClustInfo>", &m_output.emCalInfo, 6400, 99);
     m_tClustQA -> Branch("IHCalInfo", "vector<Types::ClustInfo>", &m_output.ihCalInfo, 6400, 99);
     m_tClustQA -> Branch("OHCalInfo", "vector<Types::ClustInfo>", &m_output.ohCalInfo, 6400, 99);
+
+    // add sparse tower branches if needed
+    if (m_config.doTowerQA) {
+      m_tClustQA -> Branch("EMCalTwrIndex", &m_output.emCalTwrIndex);
+      m_tClustQA -> Branch("EMCalTwrEne",   &m_output.emCalTwrEne);
+      m_tClustQA -> Branch("EMCalTwrTime",  &m_output.emCalTwrTime);
+      m_tClustQA -> Branch("IHCalTwrIndex", &m_output.ihCalTwrIndex);
+      m_tClustQA -> Branch("IHCalTwrEne",   &m_output.ihCalTwrEne);
+      m_tClustQA -> Branch("IHCalTwrTime",  &m_output.ihCalTwrTime);
+      m_tClustQA -> Branch("OHCalTwrIndex", &m_output.ohCalTwrIndex);
+      m_tClustQA -> Branch("OHCalTwrEne",   &m_output.ohCalTwrEne);
+      m_tClustQA -> Branch("OHCalTwrTime",  &m_output.ohCalTwrTime);
+    }
+
+    // add track-cluster matching branches if needed
+    if (m_config.doTrkMatch) {
+      m_tClustQA -> Branch("TrkMatchDEta",   &m_output.trkMatchDEta);
+      m_tClustQA -> Branch("TrkMatchDPhi",   &m_output.trkMatchDPhi);
+      m_tClustQA -> Branch("TrkMatchDr",     &m_output.trkMatchDr);
+      m_tClustQA -> Branch("TrkMatchEOverP", &m_output.trkMatchEOverP);
+      m_tClustQA -> Branch("TrkMatchTrkP",   &m_output.trkMatchTrkP);
+      m_tClustQA -> Branch("TrkMatchClustE", &m_output.trkMatchClustE);
+    }
     return;
 
   }  // end 'InitTree()'
 
 
 
+  void SMakeClustQATree::InitFlatTree() {
+
+    if (m_isDebugOn && (m_verbosity > 2)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitFlatTree(): initializing flat output tree." << endl;
+    }
+
+    // initialize tree, with schema version in title
+    const string sTitle = "Cluster QA (reduced summary record v" + to_string(SMakeClustQATreeRecord::Version) + ": cluster E, eta, phi only)";
+    m_tFlatQA = new TTree("tClustQAFlat", sTitle.data());
+    m_record.SetBranches(m_tFlatQA);
+    return;
+
+  }  // end 'InitFlatTree()'
+
+
+
+  void SMakeClustQATree::FillFlatTree() {
+
+    if (m_isDebugOn && (m_verbosity > 4)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::FillFlatTree(): filling flat output tree." << endl;
+    }
+
+    // copy output into record and fill
+    m_record.SetEvtInfo(m_output.recInfo, m_output.genInfo);
+    m_record.SetBlock(m_output.emCalInfo, m_record.emCal);
+    m_record.SetBlock(m_output.ihCalInfo, m_record.ihCal);
+    m_record.SetBlock(m_output.ohCalInfo, m_record.ohCal);
+    m_tFlatQA -> Fill();
+    return;
+
+  }  // end 'FillFlatTree()'
+
+
+
+  void SMakeClustQATree::InitRunHists(const int run) {
+
+    if (m_isDebugOn && (m_verbosity > 2)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitRunHists(int): initializing histograms for run " << run << "." << endl;
+    }
+
+    // if run already seen, just switch to its histograms
+    auto itRun = m_mapRunHists.find(run);
+    if (itRun != m_mapRunHists.end()) {
+      m_runHists = &(itRun -> second);
+      return;
+    }
+
+    // make sure sumw2 is on
+    TH1::SetDefaultSumw2(true);
+    TH2::SetDefaultSumw2(true);
+
+    // create run directory
+    RunHists& hists = m_mapRunHists[run];
+    const string sRunDir = "Run" + to_string(run);
+    hists.dir = m_outDir -> mkdir(sRunDir.data());
+    hists.dir -> cd();
+
+    // create histograms for each calo
+    hists.vecHist1D.resize( m_hist.vecCaloNames.size() );
+    hists.vecOccupancy.resize( m_hist.vecCaloNames.size() );
+    for (size_t iCalo = 0; iCalo < m_hist.vecCaloNames.size(); iCalo++) {
+
+      // loop over base variables
+      hists.vecHist1D[iCalo].resize( m_hist.vecBaseNames.size() );
+      for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
+
+        // make name and title
+        const string sName  = m_hist.vecBaseNames[iVar] + "_" + m_hist.vecCaloNames[iCalo] + "_" + sRunDir;
+        const string sTitle = ";" + get<0>(m_hist.vecAxisDef[iVar]) + ";counts";
+
+        hists.vecHist1D[iCalo][iVar] = new TH1D(
+          sName.data(),
+          sTitle.data(),
+          get<1>(m_hist.vecAxisDef[iVar]),
+          get<2>(m_hist.vecAxisDef[iVar]).first,
+          get<2>(m_hist.vecAxisDef[iVar]).second
+        );
+      }  // end variable loop
+
+      // make occupancy name and title
+      const string sNameOcc  = m_hist.sOccupancyName + "_" + m_hist.vecCaloNames[iCalo] + "_" + sRunDir;
+      const string sTitleOcc = ";" + get<0>(m_hist.vecAxisDef[Var::Phi]) + ";" + get<0>(m_hist.vecAxisDef[Var::Eta]) + ";counts";
+
+      // create occupancy histogram
+      hists.vecOccupancy[iCalo] = new TH2D(
+        sNameOcc.data(),
+        sTitleOcc.data(),
+        get<1>(m_hist.vecAxisDef[Var::Phi]),
+        get<2>(m_hist.vecAxisDef[Var::Phi]).first,
+        get<2>(m_hist.vecAxisDef[Var::Phi]).second,
+        get<1>(m_hist.vecAxisDef[Var::Eta]),
+        get<2>(m_hist.vecAxisDef[Var::Eta]).first,
+        get<2>(m_hist.vecAxisDef[Var::Eta]).second
+      );
+    }  // end calo loop
+
+    m_runHists = &hists;
+    return;
+
+  }  // end 'InitRunHists(int)'
+
+
+
   void SMakeClustQATree::SaveOutput() {
 
     if (m_isDebugOn && (m_verbosity > 2)) {
       cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::SaveOutput(): saving output." << endl;
     }
 
-    m_outDir   -> cd();
-    m_tClustQA -> Write();
+    m_outDir -> cd();
+    if (m_config.doTree) {
+      m_tClustQA -> Write();
+    }
+    if (m_config.doFlatTree) {
+      m_tFlatQA -> Write();
+    }
+
+    // save per-run histograms
+    for (auto& run : m_mapRunHists) {
+      run.second.dir -> cd();
+      for (auto calo : run.second.vecHist1D) {
+        for (auto hist : calo) {
+          hist -> Write();
+        }
+      }
+      for (auto hist : run.second.vecOccupancy) {
+        hist -> Write();
+      }
+    }
+    m_outDir -> cd();
+
+    // save tower geometry so sparse indices can be decoded
+    if (m_config.doTowerQA) {
+      uint64_t nEtaEMCal = m_emCalGeom.nEta;
+      uint64_t nPhiEMCal = m_emCalGeom.nPhi;
+      uint64_t nEtaIHCal = m_ihCalGeom.nEta;
+      uint64_t nPhiIHCal = m_ihCalGeom.nPhi;
+      uint64_t nEtaOHCal = m_ohCalGeom.nEta;
+      uint64_t nPhiOHCal = m_ohCalGeom.nPhi;
+
+      m_tTwrGeom = new TTree("tTwrGeom", "Tower geometry");
+      m_tTwrGeom -> Branch("EMCalNEta", &nEtaEMCal);
+      m_tTwrGeom -> Branch("EMCalNPhi", &nPhiEMCal);
+      m_tTwrGeom -> Branch("EMCalEta",  &m_emCalGeom.eta);
+      m_tTwrGeom -> Branch("EMCalPhi",  &m_emCalGeom.phi);
+      m_tTwrGeom -> Branch("IHCalNEta", &nEtaIHCal);
+      m_tTwrGeom -> Branch("IHCalNPhi", &nPhiIHCal);
+      m_tTwrGeom -> Branch("IHCalEta",  &m_ihCalGeom.eta);
+      m_tTwrGeom -> Branch("IHCalPhi",  &m_ihCalGeom.phi);
+      m_tTwrGeom -> Branch("OHCalNEta", &nEtaOHCal);
+      m_tTwrGeom -> Branch("OHCalNPhi", &nPhiOHCal);
+      m_tTwrGeom -> Branch("OHCalEta",  &m_ohCalGeom.eta);
+      m_tTwrGeom -> Branch("OHCalPhi",  &m_ohCalGeom.phi);
+      m_tTwrGeom -> Fill();
+      m_tTwrGeom -> Write();
+    }
     return;
 
   }  // end 'SaveOutput()'
 
 
 
+  void SMakeClustQATree::InitTowerGeom(PHCompositeNode* topNode, const string node) {
+
+    if (m_isDebugOn && (m_verbosity > 2)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitTowerGeom(PHCompositeNode*, string): grabbing tower geometry." << endl;
+    }
+
+    // grab geometry
+    RawTowerGeomContainer* geomNode = getClass<RawTowerGeomContainer>(topNode, node.data());
+    if (!geomNode) {
+      cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitTowerGeom(PHCompositeNode*, string) PANIC: couldn't grab node \"" << node << "\"!" << endl;
+      assert(geomNode);
+    }
+
+    // select which geometry to fill
+    TwrGeom* geom = NULL;
+    if (node == "TOWERGEOM_CEMC")    geom = &m_emCalGeom;
+    if (node == "TOWERGEOM_HCALIN")  geom = &m_ihCalGeom;
+    if (node == "TOWERGEOM_HCALOUT") geom = &m_ohCalGeom;
+    if (!geom) {
+      cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::InitTowerGeom(PHCompositeNode*, string) WARNING: trying to grab geometry from unknown node!" << endl;
+      return;
+    }
+
+    // size flat arrays
+    geom -> nEta = geomNode -> get_etabins();
+    geom -> nPhi = geomNode -> get_phibins();
+    geom -> eta.assign(geom -> nEta * geom -> nPhi, -999.);
+    geom -> phi.assign(geom -> nEta * geom -> nPhi, -999.);
+
+    // and fill with tower positions
+    RawTowerGeomContainer::ConstRange towerGeoms = geomNode -> get_tower_geometries();
+    for (
+      RawTowerGeomContainer::ConstIterator itGeom = towerGeoms.first;
+      itGeom != towerGeoms.second;
+      ++itGeom
+    ) {
+      const RawTowerGeom* twrGeom = itGeom -> second;
+      if (!twrGeom) continue;
+
+      const size_t index = (twrGeom -> get_bineta() * geom -> nPhi) + twrGeom -> get_binphi();
+      if (index >= geom -> eta.size()) continue;
+
+      geom -> eta[index] = twrGeom -> get_eta();
+      geom -> phi[index] = twrGeom -> get_phi();
+    }
+    return;
+
+  }  // end 'InitTowerGeom(PHCompositeNode*, string)'
+
+
+
   void SMakeClustQATree::DoClustLoop(PHCompositeNode* topNode, const string node) {
 
     if (m_isDebugOn && (m_verbosity > 2)) {
@@ -113,6 +400,7 @@ namespace SColdQcdCorrelatorAnalysis {
     RawClusterContainer::ConstRange clusters = Interfaces::GetClusters(topNode, node);
 
     // loop over clusters
+    uint64_t nAccept = 0;
     for (
       RawClusterContainer::ConstIterator itClust = clusters.first;
       itClust != clusters.second;
@@ -131,31 +419,207 @@ namespace SColdQcdCorrelatorAnalysis {
       Types::ClustInfo clustInfo(cluster, ROOT::Math::XYZVector(0., 0., 0.), Const::MapNodeOntoIndex()[node]);
 
       // add to relevant list
+      int iCalo = -1;
       switch (Const::MapNodeOntoIndex()[node]) {
 
         case Const::Subsys::EMCal:
           m_output.emCalInfo.push_back(clustInfo);
+          iCalo = Calo::EMCal;
           break;
 
         case Const::Subsys::IHCal:
           m_output.ihCalInfo.push_back(clustInfo);
+          iCalo = Calo::IHCal;
           break;
 
         case Const::Subsys::OHCal:
           m_output.ohCalInfo.push_back(clustInfo);
+          iCalo = Calo::OHCal;
           break;
 
         default:
           cerr << "SColdQcdCorrealtorAnalysis::SMakeClustQATree::DoClustLoop(PHCompositeNode*, string) WARNING: trying to add clusters from unknown node to output!" << endl;
           break;
       }
+
+      // fill histograms if needed
+      if (m_config.doHists && m_runHists && (iCalo >= 0)) {
+        m_runHists -> vecHist1D[iCalo][Var::Ene] -> Fill(clustInfo.GetEne());
+        m_runHists -> vecHist1D[iCalo][Var::Eta] -> Fill(clustInfo.GetEta());
+        m_runHists -> vecHist1D[iCalo][Var::Phi] -> Fill(clustInfo.GetPhi());
+        m_runHists -> vecOccupancy[iCalo]        -> Fill(clustInfo.GetPhi(), clustInfo.GetEta());
+        ++nAccept;
+      }
     }  // end cluster loop
+
+    // fill multiplicity if needed
+    if (m_config.doHists && m_runHists) {
+      switch (Const::MapNodeOntoIndex()[node]) {
+        case Const::Subsys::EMCal:
+          m_runHists -> vecHist1D[Calo::EMCal][Var::Mult] -> Fill(nAccept);
+          break;
+        case Const::Subsys::IHCal:
+          m_runHists -> vecHist1D[Calo::IHCal][Var::Mult] -> Fill(nAccept);
+          break;
+        case Const::Subsys::OHCal:
+          m_runHists -> vecHist1D[Calo::OHCal][Var::Mult] -> Fill(nAccept);
+          break;
+        default:
+          break;
+      }
+    }
     return;
 
   }  // end 'DoClustLoop(PHCompositeNode*, string)'
 
 
 
+  void SMakeClustQATree::DoTowerLoop(PHCompositeNode* topNode, const string node) {
+
+    if (m_isDebugOn && (m_verbosity > 2)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::DoTowerLoop(PHCompositeNode*, string): looping over towers." << endl;
+    }
+
+    // grab towers
+    RawTowerContainer* towers = getClass<RawTowerContainer>(topNode, node.data());
+    if (!towers) {
+      cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::DoTowerLoop(PHCompositeNode*, string) WARNING: couldn't grab node \"" << node << "\"!" << endl;
+      return;
+    }
+
+    // select relevant geometry and output lists
+    const TwrGeom*    geom  = NULL;
+    vector<uint32_t>* index = NULL;
+    vector<float>*    ene   = NULL;
+    vector<float>*    time  = NULL;
+    if (node == "TOWER_CALIB_CEMC") {
+      geom  = &m_emCalGeom;
+      index = &m_output.emCalTwrIndex;
+      ene   = &m_output.emCalTwrEne;
+      time  = &m_output.emCalTwrTime;
+    } else if (node == "TOWER_CALIB_HCALIN") {
+      geom  = &m_ihCalGeom;
+      index = &m_output.ihCalTwrIndex;
+      ene   = &m_output.ihCalTwrEne;
+      time  = &m_output.ihCalTwrTime;
+    } else if (node == "TOWER_CALIB_HCALOUT") {
+      geom  = &m_ohCalGeom;
+      index = &m_output.ohCalTwrIndex;
+      ene   = &m_output.ohCalTwrEne;
+      time  = &m_output.ohCalTwrTime;
+    } else {
+      cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::DoTowerLoop(PHCompositeNode*, string) WARNING: trying to add towers from unknown node to output!" << endl;
+      return;
+    }
+
+    // loop over towers
+    RawTowerContainer::ConstRange range = towers -> getTowers();
+    for (
+      RawTowerContainer::ConstIterator itTwr = range.first;
+      itTwr != range.second;
+      ++itTwr
+    ) {
+
+      // grab tower and skip if below threshold
+      const RawTower* tower = itTwr -> second;
+      if (!tower) continue;
+      if (tower -> get_energy() < m_config.eTowerMin) continue;
+
+      // encode position as flat index
+      const uint32_t iEta = RawTowerDefs::decode_index1(itTwr -> first);
+      const uint32_t iPhi = RawTowerDefs::decode_index2(itTwr -> first);
+      if ((iEta >= geom -> nEta) || (iPhi >= geom -> nPhi)) continue;
+
+      // add to relevant lists
+      index -> push_back((iEta * geom -> nPhi) + iPhi);
+      ene   -> push_back(tower -> get_energy());
+      time  -> push_back(tower -> get_time());
+    }  // end tower loop
+    return;
+
+  }  // end 'DoTowerLoop(PHCompositeNode*, string)'
+
+
+
+  void SMakeClustQATree::DoTrackMatching(PHCompositeNode* topNode) {
+
+    if (m_isDebugOn && (m_verbosity > 2)) {
+      cout << "SColdQcdCorrelatorAnalysis::SMakeClustQATree::DoTrackMatching(PHCompositeNode*): matching tracks to emcal clusters." << endl;
+    }
+
+    // index accepted emcal clusters in eta-phi
+    m_emCalIndex.Build(m_output.emCalInfo);
+
+    // loop over tracks
+    SvtxTrack*    track   = NULL;
+    SvtxTrackMap* mapTrks = Interfaces::GetTrackMap(topNode);
+    for (
+      SvtxTrackMap::Iter itTrk = mapTrks -> begin();
+      itTrk != mapTrks -> end();
+      ++itTrk
+    ) {
+
+      // grab track and skip if bad
+      track = itTrk -> second;
+      if (!track) continue;
+
+      const bool isGoodTrack = IsGoodTrack(track, topNode);
+      if (!isGoodTrack) continue;
+
+      // get track position at emcal: use projected state if
+      // available, otherwise fall back to vertex direction
+      double etaTrk = track -> get_eta();
+      double phiTrk = track -> get_phi();
+
+      const SvtxTrackState* state = track -> get_state(m_config.rProjEMCal);
+      if (state) {
+        const double rState = hypot(state -> get_x(), state -> get_y());
+        etaTrk = asinh(state -> get_z() / rState);
+        phiTrk = atan2(state -> get_y(), state -> get_x());
+      }
+
+      // find closest nearby cluster
+      bool   foundMatch = false;
+      size_t iMatch     = 0;
+      double drMatch    = m_config.drMatchMax;
+      double dhMatch    = 0.;
+      double dfMatch    = 0.;
+      m_emCalIndex.ForEachNear(
+        etaTrk,
+        phiTrk,
+        m_config.drMatchMax,
+        [&](const size_t iClust) {
+
+          const double dhClust = m_output.emCalInfo[iClust].GetEta() - etaTrk;
+          const double dfClust = remainder(m_output.emCalInfo[iClust].GetPhi() - phiTrk, TMath::TwoPi());
+          const double drClust = hypot(dhClust, dfClust);
+          if (drClust < drMatch) {
+            foundMatch = true;
+            iMatch     = iClust;
+            drMatch    = drClust;
+            dhMatch    = dhClust;
+            dfMatch    = dfClust;
+          }
+        }
+      );
+      if (!foundMatch) continue;
+
+      // record residuals and e/p
+      const double pTrk   = track -> get_p();
+      const double eClust = m_output.emCalInfo[iMatch].GetEne();
+      m_output.trkMatchDEta.push_back(dhMatch);
+      m_output.trkMatchDPhi.push_back(dfMatch);
+      m_output.trkMatchDr.push_back(drMatch);
+      m_output.trkMatchEOverP.push_back((pTrk > 0.) ? eClust / pTrk : -1.);
+      m_output.trkMatchTrkP.push_back(pTrk);
+      m_output.trkMatchClustE.push_back(eClust);
+    }  // end track loop
+    return;
+
+  }  // end 'DoTrackMatching(PHCompositeNode*)'
+
+
+
   bool SMakeClustQATree::IsGoodCluster(const RawCluster* cluster) {
 
     // print debug statement
@@ -172,6 +636,30 @@ namespace SColdQcdCorrelatorAnalysis {
 
   }  // end 'IsGoodTrack(RawCluster*)'
 
+
+
+  bool SMakeClustQATree::IsGoodTrack(SvtxTrack* track, PHCompositeNode* topNode) {
+
+    // print debug statement
+    if (m_isDebugOn && (m_verbosity > 4)) {
+      cout << "SMakeClustQATree::IsGoodTrack(SvtxTrack*, PHCompositeNode*) Checking if track is good..." << endl;
+    }
+
+    // grab track info
+    Types::TrkInfo info(track, topNode);
+
+    // if needed, check if track is from primary vertex
+    const bool isFromPrimVtx = m_config.useOnlyPrimVtx ? Tools::IsFromPrimaryVtx(track, topNode) : true;
+
+    // check if seed is good & track is in acceptance
+    const bool isSeedGood = Tools::IsGoodTrackSeed(track, m_config.requireSiSeed);
+    const bool isInAccept = info.IsInAcceptance(m_config.trkAccept);
+
+    // return overall goodness of track
+    return (isFromPrimVtx && isSeedGood && isInAccept);
+
+  }  // end 'IsGoodTrack(SvtxTrack*, PHCompositeNode*)'
+
 }  // end SColdQcdCorrelatorAnalysis namespace
 
 // end ------------------------------------------------------------------------
@@ -12,11 +12,16 @@
 
 // c++ utilities
 #include <string>
+#include <cassert>
 #include <vector>
+#include <map>
 #include <utility>
 // root utilities
 #include <TF1.h>
+#include <TH1.h>
+#include <TH2.h>
 #include <TTree.h>
+#include <TDirectory.h>
 #include <Math/Vector3D.h>
 // f4a libraries
 #include <fun4all/SubsysReco.h>
@@ -28,15 +33,21 @@
 #include <phool/PHIODataNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHCompositeNode.h>
+#include <phool/recoConsts.h>
 // calo includes
 #include <calobase/RawCluster.h>
 #include <calobase/RawClusterUtility.h>
 #include <calobase/RawClusterContainer.h>
 #include <calobase/RawTower.h>
+#include <calobase/RawTowerDefs.h>
 #include <calobase/RawTowerGeom.h>
 #include <calobase/RawTowerContainer.h>
 #include <calobase/RawTowerGeomContainer.h>
 #include <calotrigger/CaloTriggerInfo.h>
+// tracking libraries
+#include <trackbase_historic/SvtxTrack.h>
+#include <trackbase_historic/SvtxTrackMap.h>
+#include <trackbase_historic/SvtxTrackState.h>
 // analysis utilities
 #include <scorrelatorutilities/Tools.h>
 #include <scorrelatorutilities/Types.h>
@@ -45,7 +56,10 @@
 // plugin definitions
 #include "SBaseQAPlugin.h"
 #include "SMakeClustQATreeConfig.h"
+#include "SMakeClustQATreeHistDef.h"
+#include "SMakeClustQATreeIndex.h"
 #include "SMakeClustQATreeOutput.h"
+#include "SMakeClustQATreeRecord.h"
 
 // make common namespaces implicit
 using namespace std;
@@ -60,28 +74,84 @@ namespace SColdQcdCorrelatorAnalysis {
 
     public:
 
+      // histogram accessors
+      enum Calo {
+        EMCal,
+        IHCal,
+        OHCal
+      };
+      enum Var {
+        Ene,
+        Eta,
+        Phi,
+        Mult
+      };
+
       // ctor/dtor
       SMakeClustQATree(const string& name = "ClustQATree") : SubsysReco(name) {};
       ~SMakeClustQATree() {};
 
       // F4A methods
       int Init(PHCompositeNode*)          override;
+      int InitRun(PHCompositeNode*)       override;
       int process_event(PHCompositeNode*) override;
       int End(PHCompositeNode*)           override;
 
+      // plugin-specific setters
+      void SetHistDef(SMakeClustQATreeHistDef& def) {m_hist = def;}
+
     private:
 
       // internal methods
       void InitTree();
+      void InitFlatTree();
+      void FillFlatTree();
+      void InitRunHists(const int run);
       void SaveOutput();
+      void InitTowerGeom(PHCompositeNode* topNode, const string node);
       void DoClustLoop(PHCompositeNode* topNode, const string node);
+      void DoTowerLoop(PHCompositeNode* topNode, const string node);
+      void DoTrackMatching(PHCompositeNode* topNode);
       bool IsGoodCluster(const RawCluster* cluster);
+      bool IsGoodTrack(SvtxTrack* track, PHCompositeNode* topNode);
 
       // output
       SMakeClustQATreeOutput m_output;
 
+      // eta-phi index of emcal clusters
+      SMakeClustQATreeIndex m_emCalIndex;
+
+      // tower geometry, looked up once per run: eta/phi
+      // stored flat, indexed by (eta bin * nPhi) + phi bin
+      struct TwrGeom {
+        size_t        nEta = 0;
+        size_t        nPhi = 0;
+        vector<float> eta;
+        vector<float> phi;
+      };
+      TwrGeom m_emCalGeom;
+      TwrGeom m_ihCalGeom;
+      TwrGeom m_ohCalGeom;
+
+      // fixed-schema record for flat output
+      SMakeClustQATreeRecord m_record;
+
+      // histogram definitions
+      SMakeClustQATreeHistDef m_hist;
+
+      // per-run histograms: [calo][var] and [calo]
+      struct RunHists {
+        TDirectory*           dir = NULL;
+        vector<vector<TH1D*>> vecHist1D;
+        vector<TH2D*>         vecOccupancy;
+      };
+      map<int, RunHists> m_mapRunHists;
+      RunHists*          m_runHists = NULL;
+
       // root members
-      TTree* m_tClustQA;
+      TTree* m_tClustQA = NULL;
+      TTree* m_tTwrGeom = NULL;
+      TTree* m_tFlatQA  = NULL;
 
   };  // end SMakeClustQATree
 
@@ -23,9 +23,34 @@ namespace SColdQcdCorrelatorAnalysis {
 
     bool isEmbed;
 
+    // output options (the flat tree is a reduced
+    // summary: cluster energy, eta and phi only)
+    bool doTree     {true};
+    bool doHists    {false};
+    bool doFlatTree {false};
+
     // cluster acceptance
     pair<Types::ClustInfo, Types::ClustInfo> clustAccept;
 
+    // track-cluster matching options
+    bool   doTrkMatch     {false};
+    bool   requireSiSeed  {true};
+    bool   useOnlyPrimVtx {true};
+    double rProjEMCal     {93.5};
+    double drMatchMax     {0.2};
+
+    // track acceptance for matching
+    pair<Types::TrkInfo, Types::TrkInfo> trkAccept;
+
+    // tower-level qa options
+    bool  doTowerQA {false};
+    float eTowerMin {0.05};
+
+    // eta-phi cluster index binning
+    size_t               nIndexEtaBins {22};
+    size_t               nIndexPhiBins {64};
+    pair<double, double> rIndexEta     {-1.1, 1.1};
+
   };  // end SMakeClustQATreeConfig
 
 }  // end SColdQcdCorrelatorAnalysis namespace
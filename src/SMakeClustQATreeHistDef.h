@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// 'SMakeClustQATreeHistDef.h'
+// Derek Anderson
+// 03.30.2024
+//
+// SCorrelatorQAMaker plugin to produce the QA tree
+// for calorimeter clusters.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SMAKECLUSTQATREEHISTDEF_H
+#define SCORRELATORQAMAKER_SMAKECLUSTQATREEHISTDEF_H
+
+// c++ utilities
+#include <tuple>
+#include <string>
+#include <vector>
+#include <utility>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SMakeClustQATreeHistDef definition ---------------------------------------
+
+  struct SMakeClustQATreeHistDef {
+
+    // histogram base names
+    vector<string> vecCaloNames = {
+      "EMCal",
+      "IHCal",
+      "OHCal"
+    };
+    vector<string> vecBaseNames = {
+      "hEne",
+      "hEta",
+      "hPhi",
+      "hMult"
+    };
+    string sOccupancyName = "hEtaVsPhi";
+
+    // no. of histogram bins
+    size_t nEneBins  = 200;
+    size_t nEtaBins  = 80;
+    size_t nPhiBins  = 128;
+    size_t nMultBins = 200;
+
+    // histogram ranges
+    pair<float, float> rEneBins  = {0.,    100.};
+    pair<float, float> rEtaBins  = {-2.,   2.};
+    pair<float, float> rPhiBins  = {-3.15, 3.15};
+    pair<float, float> rMultBins = {0.,    200.};
+
+    // axis definitions
+    vector<tuple<string, size_t, pair<float, float>>> vecAxisDef = {
+      make_tuple("E_{clust} [GeV]", nEneBins,  rEneBins),
+      make_tuple("#eta_{clust}",    nEtaBins,  rEtaBins),
+      make_tuple("#varphi_{clust}", nPhiBins,  rPhiBins),
+      make_tuple("N_{clust}",       nMultBins, rMultBins)
+    };
+
+  };  // end SMakeClustQATreeHistDef
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,140 @@
+// ----------------------------------------------------------------------------
+// 'SMakeClustQATreeIndex.h'
+// Derek Anderson
+// 03.28.2024
+//
+// SCorrelatorQAMaker plugin to produce the QA tree
+// for calorimeter clusters.
+//
+// Per-event eta-phi binned index of clusters, used
+// to look up the clusters near a projected track
+// without looping over every cluster in the event.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SMAKECLUSTQATREEINDEX_H
+#define SCORRELATORQAMAKER_SMAKECLUSTQATREEINDEX_H
+
+// c++ utilities
+#include <cmath>
+#include <vector>
+#include <utility>
+// root libraries
+#include <TMath.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SMakeClustQATreeIndex definition -----------------------------------------
+
+  struct SMakeClustQATreeIndex {
+
+    // binning
+    size_t               nEtaBins = 22;
+    size_t               nPhiBins = 64;
+    pair<double, double> rEta     = {-1.1, 1.1};
+
+    // bin-ordered cluster indices: clusters in bin b are
+    // vecClustIndex[vecBinStart[b]] ... vecClustIndex[vecBinStart[b + 1] - 1]
+    vector<size_t> vecBinStart;
+    vector<size_t> vecClustIndex;
+
+    // per-cluster bin and fill cursors (kept to avoid reallocating every event)
+    vector<size_t> vecClustBin;
+    vector<size_t> vecCursor;
+
+    void SetBinning(const size_t nEta, const size_t nPhi, const pair<double, double> range) {
+      nEtaBins = (nEta > 0) ? nEta : 1;
+      nPhiBins = (nPhi > 0) ? nPhi : 1;
+      rEta     = range;
+      return;
+    }
+
+    double GetEtaBinWidth() const {return (rEta.second - rEta.first) / (double) nEtaBins;}
+    double GetPhiBinWidth() const {return TMath::TwoPi() / (double) nPhiBins;}
+
+    size_t GetEtaBin(const double eta) const {
+
+      // clamp out-of-range values onto the edge bins
+      const double pos = (eta - rEta.first) / GetEtaBinWidth();
+      if (pos < 0.) return 0;
+      const size_t bin = (size_t) pos;
+      return (bin < nEtaBins) ? bin : nEtaBins - 1;
+
+    }  // end 'GetEtaBin(double)'
+
+    size_t GetPhiBin(const double phi) const {
+
+      // wrap phi into [0, 2pi)
+      double wrap = fmod(phi, TMath::TwoPi());
+      if (wrap < 0.) wrap += TMath::TwoPi();
+      const size_t bin = (size_t) (wrap / GetPhiBinWidth());
+      return (bin < nPhiBins) ? bin : nPhiBins - 1;
+
+    }  // end 'GetPhiBin(double)'
+
+    size_t GetBin(const size_t iEta, const size_t iPhi) const {return (iEta * nPhiBins) + iPhi;}
+
+    template <typename Clust> void Build(const vector<Clust>& clusts) {
+
+      // count clusters per bin
+      const size_t nBins = nEtaBins * nPhiBins;
+      vecBinStart.assign(nBins + 1, 0);
+      vecClustBin.resize(clusts.size());
+      for (size_t iClust = 0; iClust < clusts.size(); iClust++) {
+        const size_t bin = GetBin(GetEtaBin(clusts[iClust].GetEta()), GetPhiBin(clusts[iClust].GetPhi()));
+        vecClustBin[iClust] = bin;
+        ++vecBinStart[bin + 1];
+      }
+
+      // turn counts into offsets
+      for (size_t iBin = 0; iBin < nBins; iBin++) {
+        vecBinStart[iBin + 1] += vecBinStart[iBin];
+      }
+
+      // and scatter cluster indices into their bins
+      vecCursor.assign(vecBinStart.begin(), vecBinStart.end() - 1);
+      vecClustIndex.resize(clusts.size());
+      for (size_t iClust = 0; iClust < clusts.size(); iClust++) {
+        vecClustIndex[vecCursor[vecClustBin[iClust]]++] = iClust;
+      }
+      return;
+
+    }  // end 'Build(vector<Clust>&)'
+
+    template <typename Func> void ForEachNear(const double eta, const double phi, const double rMax, Func func) const {
+
+      // no. of neighboring bins to check on each side
+      const size_t nAdjEta = (size_t) ceil(rMax / GetEtaBinWidth());
+      const size_t nAdjPhi = min((size_t) ceil(rMax / GetPhiBinWidth()), nPhiBins / 2);
+
+      // eta range (clamped) and phi range (wrapped)
+      const size_t iEtaCenter = GetEtaBin(eta);
+      const size_t iPhiCenter = GetPhiBin(phi);
+      const size_t iEtaStart  = (iEtaCenter > nAdjEta) ? iEtaCenter - nAdjEta : 0;
+      const size_t iEtaStop   = min(iEtaCenter + nAdjEta, nEtaBins - 1);
+      const size_t nPhiCheck  = min((2 * nAdjPhi) + 1, nPhiBins);
+
+      for (size_t iEta = iEtaStart; iEta <= iEtaStop; iEta++) {
+        for (size_t iStep = 0; iStep < nPhiCheck; iStep++) {
+          const size_t iPhi = (iPhiCenter + nPhiBins - nAdjPhi + iStep) % nPhiBins;
+          const size_t bin  = GetBin(iEta, iPhi);
+          for (size_t iEntry = vecBinStart[bin]; iEntry < vecBinStart[bin + 1]; iEntry++) {
+            func(vecClustIndex[iEntry]);
+          }
+        }  // end phi loop
+      }  // end eta loop
+      return;
+
+    }  // end 'ForEachNear(double, double, double, Func)'
+
+  };  // end SMakeClustQATreeIndex
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
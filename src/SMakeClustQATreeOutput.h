@@ -30,12 +30,47 @@ namespace SColdQcdCorrelatorAnalysis {
     vector<Types::ClustInfo> ihCalInfo;
     vector<Types::ClustInfo> ohCalInfo;
 
+    // sparse tower info: only towers above threshold,
+    // index = (eta bin * no. of phi bins) + phi bin
+    vector<uint32_t> emCalTwrIndex;
+    vector<uint32_t> ihCalTwrIndex;
+    vector<uint32_t> ohCalTwrIndex;
+    vector<float>    emCalTwrEne;
+    vector<float>    ihCalTwrEne;
+    vector<float>    ohCalTwrEne;
+    vector<float>    emCalTwrTime;
+    vector<float>    ihCalTwrTime;
+    vector<float>    ohCalTwrTime;
+
+    // track-emcal matching info
+    vector<float> trkMatchDEta;
+    vector<float> trkMatchDPhi;
+    vector<float> trkMatchDr;
+    vector<float> trkMatchEOverP;
+    vector<float> trkMatchTrkP;
+    vector<float> trkMatchClustE;
+
     void Reset() {
       recInfo.Reset();
       genInfo.Reset();
       emCalInfo.clear();
       ihCalInfo.clear();
       ohCalInfo.clear();
+      emCalTwrIndex.clear();
+      ihCalTwrIndex.clear();
+      ohCalTwrIndex.clear();
+      emCalTwrEne.clear();
+      ihCalTwrEne.clear();
+      ohCalTwrEne.clear();
+      emCalTwrTime.clear();
+      ihCalTwrTime.clear();
+      ohCalTwrTime.clear();
+      trkMatchDEta.clear();
+      trkMatchDPhi.clear();
+      trkMatchDr.clear();
+      trkMatchEOverP.clear();
+      trkMatchTrkP.clear();
+      trkMatchClustE.clear();
       return;
     }
 
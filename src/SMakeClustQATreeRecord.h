@@ -0,0 +1,162 @@
+// ----------------------------------------------------------------------------
+// 'SMakeClustQATreeRecord.h'
+// Derek Anderson
+// 03.31.2024
+//
+// SCorrelatorQAMaker plugin to produce the QA tree
+// for calorimeter clusters.
+//
+// Fixed-schema, versioned event record for the cluster
+// QA. Everything is written as flat leaves (scalars and
+// counted arrays of PODs), so neither writing nor
+// reading needs any dictionary or streamer calls.
+//
+// This is a reduced summary, not a copy of the main
+// tree: only the energy, eta and phi of each cluster
+// are kept, and clusters beyond MaxClust per calo are
+// dropped (the no. dropped is kept per event).
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SMAKECLUSTQATREERECORD_H
+#define SCORRELATORQAMAKER_SMAKECLUSTQATREERECORD_H
+
+// c++ utilities
+#include <string>
+#include <vector>
+#include <iostream>
+// root libraries
+#include <TTree.h>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SMakeClustQATreeRecord definition ----------------------------------------
+
+  struct SMakeClustQATreeRecord {
+
+    // schema version: bump whenever the layout below changes
+    static const uint16_t Version  = 2;
+    static const int32_t  MaxClust = 4096;
+
+    // per-calo cluster block: n is the no. of clusters
+    // kept, and nTrunc the no. dropped past MaxClust
+    struct ClustBlock {
+      int32_t n      = 0;
+      int32_t nTrunc = 0;
+      float   ene[MaxClust];
+      float   eta[MaxClust];
+      float   phi[MaxClust];
+    };
+
+    // record version
+    uint16_t version = Version;
+
+    // reco event info
+    int32_t nTrks     = 0;
+    float   pSumTrks  = 0.;
+    float   eSumEMCal = 0.;
+    float   eSumIHCal = 0.;
+    float   eSumOHCal = 0.;
+    float   vx        = 0.;
+    float   vy        = 0.;
+    float   vz        = 0.;
+
+    // gen event info
+    int32_t nChrgPar = 0;
+    int32_t nNeuPar  = 0;
+    int32_t isEmbed  = 0;
+    float   eSumChrg = 0.;
+    float   eSumNeu  = 0.;
+
+    // clusters
+    ClustBlock emCal;
+    ClustBlock ihCal;
+    ClustBlock ohCal;
+
+    void SetBranches(TTree* tree) {
+
+      tree -> Branch("Version",   &version,   "Version/s");
+      tree -> Branch("NTrks",     &nTrks,     "NTrks/I");
+      tree -> Branch("PSumTrks",  &pSumTrks,  "PSumTrks/F");
+      tree -> Branch("ESumEMCal", &eSumEMCal, "ESumEMCal/F");
+      tree -> Branch("ESumIHCal", &eSumIHCal, "ESumIHCal/F");
+      tree -> Branch("ESumOHCal", &eSumOHCal, "ESumOHCal/F");
+      tree -> Branch("VX",        &vx,        "VX/F");
+      tree -> Branch("VY",        &vy,        "VY/F");
+      tree -> Branch("VZ",        &vz,        "VZ/F");
+      tree -> Branch("NChrgPar",  &nChrgPar,  "NChrgPar/I");
+      tree -> Branch("NNeuPar",   &nNeuPar,   "NNeuPar/I");
+      tree -> Branch("IsEmbed",   &isEmbed,   "IsEmbed/I");
+      tree -> Branch("ESumChrg",  &eSumChrg,  "ESumChrg/F");
+      tree -> Branch("ESumNeu",   &eSumNeu,   "ESumNeu/F");
+      SetBlockBranches(tree, "EMCal", emCal);
+      SetBlockBranches(tree, "IHCal", ihCal);
+      SetBlockBranches(tree, "OHCal", ohCal);
+      return;
+
+    }  // end 'SetBranches(TTree*)'
+
+    void SetBlockBranches(TTree* tree, const string calo, ClustBlock& block) {
+
+      const string sCount = "N" + calo;
+      const string sTrunc = "N" + calo + "Trunc";
+      tree -> Branch(sCount.data(),         &block.n,      (sCount + "/I").data());
+      tree -> Branch(sTrunc.data(),         &block.nTrunc, (sTrunc + "/I").data());
+      tree -> Branch((calo + "Ene").data(), block.ene,     (calo + "Ene[" + sCount + "]/F").data());
+      tree -> Branch((calo + "Eta").data(), block.eta,     (calo + "Eta[" + sCount + "]/F").data());
+      tree -> Branch((calo + "Phi").data(), block.phi,     (calo + "Phi[" + sCount + "]/F").data());
+      return;
+
+    }  // end 'SetBlockBranches(TTree*, string, ClustBlock&)'
+
+    template <typename Reco, typename Gen> void SetEvtInfo(const Reco& reco, const Gen& gen) {
+
+      nTrks     = reco.GetNTrks();
+      pSumTrks  = reco.GetPSumTrks();
+      eSumEMCal = reco.GetESumEMCal();
+      eSumIHCal = reco.GetESumIHCal();
+      eSumOHCal = reco.GetESumOHCal();
+      vx        = reco.GetVX();
+      vy        = reco.GetVY();
+      vz        = reco.GetVZ();
+      nChrgPar  = gen.GetNChrgPar();
+      nNeuPar   = gen.GetNNeuPar();
+      isEmbed   = gen.GetIsEmbed();
+      eSumChrg  = gen.GetESumChrg();
+      eSumNeu   = gen.GetESumNeu();
+      return;
+
+    }  // end 'SetEvtInfo(Reco&, Gen&)'
+
+    template <typename Clust> void SetBlock(const vector<Clust>& clusts, ClustBlock& block) {
+
+      // truncate if over fixed size, keeping track of
+      // how many were dropped
+      block.n      = (int32_t) clusts.size();
+      block.nTrunc = 0;
+      if (block.n > MaxClust) {
+        cerr << "SColdQcdCorrelatorAnalysis::SMakeClustQATreeRecord::SetBlock(vector<Clust>&, ClustBlock&) WARNING: " << block.n << " clusters exceeds record size, truncating to " << MaxClust << "!" << endl;
+        block.nTrunc = block.n - MaxClust;
+        block.n      = MaxClust;
+      }
+
+      for (int32_t iClust = 0; iClust < block.n; iClust++) {
+        block.ene[iClust] = clusts[iClust].GetEne();
+        block.eta[iClust] = clusts[iClust].GetEta();
+        block.phi[iClust] = clusts[iClust].GetPhi();
+      }
+      return;
+
+    }  // end 'SetBlock(vector<Clust>&, ClustBlock&)'
+
+  };  // end SMakeClustQATreeRecord
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,170 @@
+// ----------------------------------------------------------------------------
+// 'SProgressMeter.h'
+// Derek Anderson
+// 04.04.2024
+//
+// Progress and throughput meter for standalone event
+// loops. Instead of printing a line for every event,
+// a status line (events/s, MB/s read, and ETA) is
+// only printed once per time interval, followed by a
+// summary line at the end of the loop.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SPROGRESSMETER_H
+#define SCORRELATORQAMAKER_SPROGRESSMETER_H
+
+// c++ utilities
+#include <chrono>
+#include <string>
+#include <iomanip>
+#include <iostream>
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SProgressMeter definition ------------------------------------------------
+
+  class SProgressMeter {
+
+    public:
+
+      // ctor/dtor
+      SProgressMeter()  {};
+      ~SProgressMeter() {};
+
+      // setters
+      void SetInterval(const double interval) {m_interval = interval;}
+      void SetPrefix(const string prefix)     {m_prefix   = prefix;}
+      void SetQuiet(const bool quiet)         {m_isQuiet  = quiet;}
+
+      void Start(const int64_t nTotal) {
+
+        m_nTotal = nTotal;
+        m_nDone  = 0;
+        m_nBytes = 0;
+        m_start  = chrono::steady_clock::now();
+        m_last   = m_start;
+        return;
+
+      }  // end 'Start(int64_t)'
+
+      void Update(const int64_t bytes) {
+
+        ++m_nDone;
+        m_nBytes += bytes;
+        PrintIfDue();
+        return;
+
+      }  // end 'Update(int64_t)'
+
+      void Update(const int64_t nDone, const int64_t nBytes) {
+
+        // for counts kept elsewhere, e.g. shared by
+        // worker threads while they run
+        Set(nDone, nBytes);
+        PrintIfDue();
+        return;
+
+      }  // end 'Update(int64_t, int64_t)'
+
+      void Set(const int64_t nDone, const int64_t nBytes) {
+
+        // set totals without printing
+        m_nDone  = nDone;
+        m_nBytes = nBytes;
+        return;
+
+      }  // end 'Set(int64_t, int64_t)'
+
+      void Add(const int64_t nDone, const int64_t nBytes) {
+
+        // for collecting counts from elsewhere, e.g.
+        // other threads, without printing
+        m_nDone  += nDone;
+        m_nBytes += nBytes;
+        return;
+
+      }  // end 'Add(int64_t, int64_t)'
+
+      void Finish() {
+
+        if (m_isQuiet) return;
+        Print(true);
+        return;
+
+      }  // end 'Finish()'
+
+      // getters
+      int64_t GetNDone()  const {return m_nDone;}
+      int64_t GetNBytes() const {return m_nBytes;}
+
+    private:
+
+      void PrintIfDue() {
+
+        // only print once per interval
+        if (m_isQuiet) return;
+
+        const chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        if (chrono::duration<double>(now - m_last).count() < m_interval) return;
+
+        m_last = now;
+        Print(false);
+        return;
+
+      }  // end 'PrintIfDue()'
+
+      void Print(const bool isFinal) const {
+
+        // calculate rates
+        const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - m_start).count();
+        const double evtRate = (elapsed > 0.) ? (double) m_nDone / elapsed : 0.;
+        const double mbRate  = (elapsed > 0.) ? ((double) m_nBytes / 1.0e6) / elapsed : 0.;
+
+        ios oldState(nullptr);
+        oldState.copyfmt(cout);
+        cout << fixed << setprecision(1) << m_prefix;
+        if (isFinal) {
+          cout << "Processed " << m_nDone << " entries in " << elapsed << " s: "
+               << evtRate << " evt/s, "
+               << mbRate  << " MB/s (" << ((double) m_nBytes / 1.0e6) << " MB read)"
+               << endl;
+        } else {
+          const double percent = (m_nTotal > 0) ? 100. * (double) m_nDone / (double) m_nTotal : 0.;
+          const double eta     = (evtRate > 0.) ? (double) (m_nTotal - m_nDone) / evtRate : 0.;
+          cout << "Processed " << m_nDone << "/" << m_nTotal << " entries (" << percent << "%): "
+               << evtRate << " evt/s, "
+               << mbRate  << " MB/s, ETA "
+               << eta     << " s"
+               << endl;
+        }
+        cout.copyfmt(oldState);
+        return;
+
+      }  // end 'Print(bool)'
+
+      // options
+      bool    m_isQuiet  = false;
+      double  m_interval = 10.;
+      string  m_prefix   = "      ";
+
+      // counters
+      int64_t m_nTotal = 0;
+      int64_t m_nDone  = 0;
+      int64_t m_nBytes = 0;
+
+      // timing
+      chrono::steady_clock::time_point m_start;
+      chrono::steady_clock::time_point m_last;
+
+  };  // end SProgressMeter
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
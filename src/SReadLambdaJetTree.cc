@@ -27,13 +27,52 @@ namespace SColdQcdCorrelatorAnalysis {
     // announce start
     cout << "\n  Starting lambda jet tree reader!" << endl;
 
+    // check histograms against memory budget (this
+    // may switch on sparse histograms, and turns off
+    // the fill table and rdataframe)
+    InitHistPolicy();
+
+    // skim, tuple, replicas and sparse histograms need
+    // the hand-written loop
+    const bool needsLoop = (
+      m_config.doSkim ||
+      m_config.doTuple ||
+      (m_config.nReplicas > 0) ||
+      m_config.useSparse ||
+      m_config.resume ||
+      IsCheckpointOn()
+    );
+    if (m_config.useRDataFrame && needsLoop) {
+      cout << "    Skim/tuple/replica/sparse output or checkpointing requested: using event loop instead of RDataFrame." << endl;
+      m_config.useRDataFrame = false;
+    }
+
+    // sparse histograms replace the fill table
+    if (m_config.useSparse) {
+      m_config.useFillTable = false;
+    }
+
     // initialize output
     InitOutput();
 
     // run internal routines
     InitInput();
+
+    // rdataframe and skim are only set up for trees
+    if (m_reader -> IsNTuple() && (m_config.useRDataFrame || m_config.doSkim)) {
+      cout << "    RDataFrame and skim need TTree input: reading RNTuple with event loop and no skim." << endl;
+      m_config.useRDataFrame = false;
+      m_config.doSkim        = false;
+    }
+    InitRange();
     InitTree();
     InitHists();
+    if (m_config.resume) {
+      ReadCheckpoint();
+    }
+    if (m_config.doSkim) {
+      InitSkim();
+    }
     return;
 
   }  // end 'Init()'
@@ -42,7 +81,21 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SReadLambdaJetTree::Analyze() {
 
-    DoAnalysis();
+    // skim, tuple and checkpoints are written from a
+    // single event loop
+    const bool isSingleLoop = (m_config.doSkim || m_config.doTuple || m_config.resume || IsCheckpointOn());
+    const bool isThreaded   = (m_config.nThreads > 1) && !isSingleLoop;
+    if (isSingleLoop && (m_config.nThreads > 1)) {
+      cout << "    Skim/tuple output and checkpoints are written in one thread: ignoring nThreads = " << m_config.nThreads << "." << endl;
+    }
+
+    if (m_config.useRDataFrame) {
+      DoRDataFrameAnalysis();
+    } else if (isThreaded) {
+      DoParallelAnalysis();
+    } else {
+      DoAnalysis();
+    }
     return;
 
   }  // end 'Analyze()'
@@ -51,9 +104,25 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SReadLambdaJetTree::End() {
 
+    // collect results from worker threads
+    if (!m_vecWorkers.empty()) {
+      MergeWorkers();
+    }
+
+    // create histograms from fill table or
+    // sparse histograms
+    if (m_config.useSparse) {
+      ProjectSparse();
+    } else if (m_config.useFillTable && !m_config.useRDataFrame) {
+      MaterializeHists();
+    }
+
     // run internal routines
     SetHistogramStyles();
     SaveOutput();
+    if (m_config.doSkim) {
+      SaveSkim();
+    }
     CloseInput();
 
     // close output
@@ -71,25 +140,32 @@ namespace SColdQcdCorrelatorAnalysis {
 
   void SReadLambdaJetTree::InitInput() {
 
-    // open input files
-    m_fInput = new TFile(m_config.inFileName.data(), "read");
-    if (!m_fInput) {
-      cerr << "PANIC: couldn't open input file:\n"
-           << "       \"" << m_config.inFileName << "\"\n"
-           << endl;
-      assert(m_fInput);
+    // collect input files into a chain
+    m_tInput = new TChain(m_config.inTreeName.data());
+    if (!m_config.inFileName.empty()) {
+      AddInputFiles(m_config.inFileName);
     }
-    cout << "    Opened input file:\n"
-         << "      \"" << m_config.inFileName << "\""
-         << endl;
+    for (const string& file : m_config.vecInFiles) {
+      AddInputFiles(file);
+    }
+
+    // make sure there's something to read
+    const int32_t nFiles = m_tInput -> GetListOfFiles() -> GetEntries();
+    if (nFiles == 0) {
+      cerr << "PANIC: couldn't find any input files for tree \"" << m_config.inTreeName << "\"!\n" << endl;
+      assert(nFiles > 0);
+    }
+    cout << "    Chained " << nFiles << " input file(s) for tree \"" << m_config.inTreeName << "\"." << endl;
+
+    // open tree or rntuple in each file
+    m_reader = new SInputReader();
+    m_reader -> Open(m_tInput, m_config.inFormat);
 
-    // grab input tree
-    m_tInput = (TTree*) m_fInput -> Get(m_config.inTreeName.data());
-    if (!m_tInput) {
-      cerr << "PANIC: couldn't grab input tree \"" << m_config.inTreeName << "\"!\n" << endl;
-      assert(m_tInput);
+    // let rntuple decompress pages in parallel
+    if (m_reader -> IsNTuple() && (m_config.nUnzipThreads > 0) && !m_isWorker) {
+      ROOT::EnableImplicitMT(m_config.nUnzipThreads);
+      cout << "    Decompressing RNTuple pages over " << m_config.nUnzipThreads << " threads." << endl;
     }
-    cout << "    Grabbed input tree \"" << m_config.inTreeName << "\"." << endl;
 
     // exit routine
     return;
@@ -98,56 +174,138 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
+  void SReadLambdaJetTree::InitRange() {
+
+    // select entries to process
+    m_range.Set(
+      m_reader -> GetEntries(),
+      m_config.firstEntry,
+      m_config.lastEntry,
+      m_config.iShard,
+      m_config.nShards
+    );
+    m_firstEntry = m_range.first;
+    m_lastEntry  = m_range.last;
+    cout << "    Processing entries [" << m_range.first << ", " << m_range.last << ")"
+         << " (shard " << m_range.iShard << " of " << m_range.nShards << ")."
+         << endl;
+
+    // exit routine
+    return;
+
+  }  // end 'InitRange()'
+
+
+
+  void SReadLambdaJetTree::AddInputFiles(const string input) {
+
+    // if not a list file, let the chain handle
+    // it (including any wildcards)
+    const bool isList = (
+      (input.size() > 5 && input.compare(input.size() - 5, 5, ".list") == 0) ||
+      (input.size() > 4 && input.compare(input.size() - 4, 4, ".txt") == 0)
+    );
+    if (!isList) {
+      const int32_t nAdded = m_tInput -> Add(input.data());
+      if (nAdded == 0) {
+        cerr << "WARNING: no input files matched \"" << input << "\"!" << endl;
+      }
+      return;
+    }
+
+    // otherwise read one file (or glob) per line,
+    // skipping blank lines and comments
+    ifstream list(input.data());
+    if (!list.is_open()) {
+      cerr << "PANIC: couldn't open input list:\n"
+           << "       \"" << input << "\"\n"
+           << endl;
+      assert(list.is_open());
+    }
+
+    string line;
+    while (getline(list, line)) {
+      const size_t start = line.find_first_not_of(" \t");
+      if ((start == string::npos) || (line[start] == '#')) continue;
+
+      const size_t stop = line.find_last_not_of(" \t\r");
+      AddInputFiles(line.substr(start, stop - start + 1));
+    }
+    return;
+
+  }  // end 'AddInputFiles(string)'
+
+
+
   void SReadLambdaJetTree::InitTree() {
 
-    // set branch addresses
-    m_tInput -> SetMakeClass(1);
-    m_tInput -> SetBranchAddress("EvtNJets",       &m_evtNJets,       &m_brEvtNJets);
-    m_tInput -> SetBranchAddress("EvtNLambdas",    &m_evtNLambdas,    &m_brEvtNLambdas);
-    m_tInput -> SetBranchAddress("EvtNTaggedJets", &m_evtNTaggedJets, &m_brEvtNTaggedJets);
-    m_tInput -> SetBranchAddress("EvtNChrgPars",   &m_evtNChrgPars,   &m_brEvtNChrgPars);
-    m_tInput -> SetBranchAddress("EvtNNeuPars",    &m_evtNNeuPars,    &m_brEvtNNeuPars);
-    m_tInput -> SetBranchAddress("EvtSumEPar",     &m_evtSumEPar,     &m_brEvtSumEPar);
-    m_tInput -> SetBranchAddress("EvtVtxX",        &m_evtVtxX,        &m_brEvtVtxX);
-    m_tInput -> SetBranchAddress("EvtVtxY",        &m_evtVtxY,        &m_brEvtVtxY);
-    m_tInput -> SetBranchAddress("EvtVtxZ",        &m_evtVtxZ,        &m_brEvtVtxZ);
-    m_tInput -> SetBranchAddress("PartonA_ID",     &m_partonA_ID,     &m_brPartonA_ID);
-    m_tInput -> SetBranchAddress("PartonB_ID",     &m_partonB_ID,     &m_brPartonB_ID);
-    m_tInput -> SetBranchAddress("PartonA_Px",     &m_partonA_Px,     &m_brPartonA_Px);
-    m_tInput -> SetBranchAddress("PartonA_Py",     &m_partonA_Py,     &m_brPartonA_Py);
-    m_tInput -> SetBranchAddress("PartonA_Pz",     &m_partonA_Pz,     &m_brPartonA_Pz);
-    m_tInput -> SetBranchAddress("PartonA_E",      &m_partonA_E,      &m_brPartonA_E);
-    m_tInput -> SetBranchAddress("PartonB_Px",     &m_partonB_Px,     &m_brPartonB_Px);
-    m_tInput -> SetBranchAddress("PartonB_Py",     &m_partonB_Py,     &m_brPartonB_Py);
-    m_tInput -> SetBranchAddress("PartonB_Pz",     &m_partonB_Pz,     &m_brPartonB_Pz);
-    m_tInput -> SetBranchAddress("PartonB_E",      &m_partonB_E,      &m_brPartonB_E);
-    m_tInput -> SetBranchAddress("LambdaID",       &m_lambdaID,       &m_brLambdaID);
-    m_tInput -> SetBranchAddress("LambdaPID",      &m_lambdaPID,      &m_brLambdaPID);
-    m_tInput -> SetBranchAddress("LambdaJetID",    &m_lambdaJetID,    &m_brLambdaJetID);
-    m_tInput -> SetBranchAddress("LambdaEmbedID",  &m_lambdaEmbedID,  &m_brLambdaEmbedID);
-    m_tInput -> SetBranchAddress("LambdaZ",        &m_lambdaZ,        &m_brLambdaZ);
-    m_tInput -> SetBranchAddress("LambdaDr",       &m_lambdaDr,       &m_brLambdaDr);
-    m_tInput -> SetBranchAddress("LambdaEnergy",   &m_lambdaEnergy,   &m_brLambdaEnergy);
-    m_tInput -> SetBranchAddress("LambdaPt",       &m_lambdaPt,       &m_brLambdaPt);
-    m_tInput -> SetBranchAddress("LambdaEta",      &m_lambdaEta,      &m_brLambdaEta);
-    m_tInput -> SetBranchAddress("LambdaPhi",      &m_lambdaPhi,      &m_brLambdaPhi);
-    m_tInput -> SetBranchAddress("JetHasLambda",   &m_jetHasLambda,   &m_brJetHasLambda);
-    m_tInput -> SetBranchAddress("JetNCst",        &m_jetNCst,        &m_brJetNCst);
-    m_tInput -> SetBranchAddress("JetID",          &m_jetID,          &m_brJetID);
-    m_tInput -> SetBranchAddress("JetE",           &m_jetE,           &m_brJetE);
-    m_tInput -> SetBranchAddress("JetPt",          &m_jetPt,          &m_brJetPt);
-    m_tInput -> SetBranchAddress("JetEta",         &m_jetEta,         &m_brJetEta);
-    m_tInput -> SetBranchAddress("JetPhi",         &m_jetPhi,         &m_brJetPhi);
-    m_tInput -> SetBranchAddress("CstID",          &m_cstID,          &m_brCstID);
-    m_tInput -> SetBranchAddress("CstPID",         &m_cstPID,         &m_brCstPID);
-    m_tInput -> SetBranchAddress("CstJetID",       &m_cstJetID,       &m_brCstJetID);
-    m_tInput -> SetBranchAddress("CstEmbedID",     &m_cstEmbedID,     &m_brCstEmbedID);
-    m_tInput -> SetBranchAddress("CstZ",           &m_cstZ,           &m_brCstZ);
-    m_tInput -> SetBranchAddress("CstDr",          &m_cstDr,          &m_brCstDr);
-    m_tInput -> SetBranchAddress("CstEnergy",      &m_cstEnergy,      &m_brCstEnergy);
-    m_tInput -> SetBranchAddress("CstPt",          &m_cstPt,          &m_brCstPt);
-    m_tInput -> SetBranchAddress("CstEta",         &m_cstEta,         &m_brCstEta);
-    m_tInput -> SetBranchAddress("CstPhi",         &m_cstPhi,         &m_brCstPhi);
+    // bind input fields
+    m_reader -> Bind("EvtNJets",       &m_evtNJets,       &m_brEvtNJets);
+    m_reader -> Bind("EvtNLambdas",    &m_evtNLambdas,    &m_brEvtNLambdas);
+    m_reader -> Bind("EvtNTaggedJets", &m_evtNTaggedJets, &m_brEvtNTaggedJets);
+    m_reader -> Bind("EvtNChrgPars",   &m_evtNChrgPars,   &m_brEvtNChrgPars);
+    m_reader -> Bind("EvtNNeuPars",    &m_evtNNeuPars,    &m_brEvtNNeuPars);
+    m_reader -> Bind("EvtSumEPar",     &m_evtSumEPar,     &m_brEvtSumEPar);
+    m_reader -> Bind("EvtVtxX",        &m_evtVtxX,        &m_brEvtVtxX);
+    m_reader -> Bind("EvtVtxY",        &m_evtVtxY,        &m_brEvtVtxY);
+    m_reader -> Bind("EvtVtxZ",        &m_evtVtxZ,        &m_brEvtVtxZ);
+    m_reader -> Bind("PartonA_ID",     &m_partonA_ID,     &m_brPartonA_ID);
+    m_reader -> Bind("PartonB_ID",     &m_partonB_ID,     &m_brPartonB_ID);
+    m_reader -> Bind("PartonA_Px",     &m_partonA_Px,     &m_brPartonA_Px);
+    m_reader -> Bind("PartonA_Py",     &m_partonA_Py,     &m_brPartonA_Py);
+    m_reader -> Bind("PartonA_Pz",     &m_partonA_Pz,     &m_brPartonA_Pz);
+    m_reader -> Bind("PartonA_E",      &m_partonA_E,      &m_brPartonA_E);
+    m_reader -> Bind("PartonB_Px",     &m_partonB_Px,     &m_brPartonB_Px);
+    m_reader -> Bind("PartonB_Py",     &m_partonB_Py,     &m_brPartonB_Py);
+    m_reader -> Bind("PartonB_Pz",     &m_partonB_Pz,     &m_brPartonB_Pz);
+    m_reader -> Bind("PartonB_E",      &m_partonB_E,      &m_brPartonB_E);
+    m_reader -> Bind("LambdaID",       &m_lambdaID,       &m_brLambdaID);
+    m_reader -> Bind("LambdaPID",      &m_lambdaPID,      &m_brLambdaPID);
+    m_reader -> Bind("LambdaJetID",    &m_lambdaJetID,    &m_brLambdaJetID);
+    m_reader -> Bind("LambdaEmbedID",  &m_lambdaEmbedID,  &m_brLambdaEmbedID);
+    m_reader -> Bind("LambdaZ",        &m_lambdaZ,        &m_brLambdaZ);
+    m_reader -> Bind("LambdaDr",       &m_lambdaDr,       &m_brLambdaDr);
+    m_reader -> Bind("LambdaEnergy",   &m_lambdaEnergy,   &m_brLambdaEnergy);
+    m_reader -> Bind("LambdaPt",       &m_lambdaPt,       &m_brLambdaPt);
+    m_reader -> Bind("LambdaEta",      &m_lambdaEta,      &m_brLambdaEta);
+    m_reader -> Bind("LambdaPhi",      &m_lambdaPhi,      &m_brLambdaPhi);
+    m_reader -> Bind("JetHasLambda",   &m_jetHasLambda,   &m_brJetHasLambda);
+    m_reader -> Bind("JetNCst",        &m_jetNCst,        &m_brJetNCst);
+    m_reader -> Bind("JetID",          &m_jetID,          &m_brJetID);
+    m_reader -> Bind("JetE",           &m_jetE,           &m_brJetE);
+    m_reader -> Bind("JetPt",          &m_jetPt,          &m_brJetPt);
+    m_reader -> Bind("JetEta",         &m_jetEta,         &m_brJetEta);
+    m_reader -> Bind("JetPhi",         &m_jetPhi,         &m_brJetPhi);
+    m_reader -> Bind("CstID",          &m_cstID,          &m_brCstID);
+    m_reader -> Bind("CstPID",         &m_cstPID,         &m_brCstPID);
+    m_reader -> Bind("CstJetID",       &m_cstJetID,       &m_brCstJetID);
+    m_reader -> Bind("CstEmbedID",     &m_cstEmbedID,     &m_brCstEmbedID);
+    m_reader -> Bind("CstZ",           &m_cstZ,           &m_brCstZ);
+    m_reader -> Bind("CstDr",          &m_cstDr,          &m_brCstDr);
+    m_reader -> Bind("CstEnergy",      &m_cstEnergy,      &m_brCstEnergy);
+    m_reader -> Bind("CstPt",          &m_cstPt,          &m_brCstPt);
+    m_reader -> Bind("CstEta",         &m_cstEta,         &m_brCstEta);
+    m_reader -> Bind("CstPhi",         &m_cstPhi,         &m_brCstPhi);
+
+    // turn off branches which aren't needed
+    if (!m_config.vecInBranches.empty()) {
+      m_reader -> SetActive(m_config.vecInBranches);
+      cout << "    Reading only " << m_config.vecInBranches.size() << " input branches." << endl;
+    }
+
+    // set up tree cache (rntuples have their own)
+    if ((m_config.cacheSize > 0) && !m_reader -> IsNTuple()) {
+      m_tInput -> SetCacheSize(m_config.cacheSize);
+      if (m_config.vecInBranches.empty()) {
+        m_tInput -> AddBranchToCache("*", true);
+      } else {
+        for (const string& branch : m_config.vecInBranches) {
+          m_tInput -> AddBranchToCache(branch.data(), true);
+        }
+      }
+      m_tInput -> SetCacheLearnEntries(m_config.nCacheLearn);
+      cout << "    Set tree cache size to " << m_config.cacheSize << " bytes." << endl;
+    }
     cout << "    Initialized input tree." << endl;
 
     // exit routine
@@ -163,54 +321,263 @@ namespace SColdQcdCorrelatorAnalysis {
     TH1::SetDefaultSumw2(true);
     TH2::SetDefaultSumw2(true);
 
-    // create event histograms
-    for (auto evtNameAndTitle : m_hist.vecEvtNameAndTitles) {
-      vecHistEvt.push_back(
-        new TH1D(
-          evtNameAndTitle.first.data(),
-          evtNameAndTitle.second.data(),
-          m_hist.nNumBins,
-          m_hist.rNumBins.first,
-          m_hist.rNumBins.second
-        )
-      );
+    // collect cut sets: main configuration goes
+    // first, then any additional sets
+    SReadLambdaJetTreeCuts cutsMain = {
+      .name      = "",
+      .ptJetMin  = m_config.ptJetMin,
+      .ptLamMin  = m_config.ptLamMin,
+      .etaJetMax = m_config.etaJetMax,
+      .etaLamMax = m_config.etaLamMax,
+      .zLeadMin  = m_config.zLeadMin
+    };
+    m_vecOutputs.resize(m_config.vecCutSets.size() + 1);
+    m_vecOutputs[0].cuts = cutsMain;
+    for (size_t iSet = 0; iSet < m_config.vecCutSets.size(); iSet++) {
+      m_vecOutputs[iSet + 1].cuts = m_config.vecCutSets[iSet];
+      if (m_vecOutputs[iSet + 1].cuts.name.empty()) {
+        m_vecOutputs[iSet + 1].cuts.name = "CutSet" + to_string(iSet + 1);
+      }
+    }
+
+    // initialize counters
+    m_nEvt.assign(m_hist.vecTypeNames.size(), 0);
+    if (m_config.nReplicas > 0) {
+      m_bootWeights.Init(m_config.nReplicas, m_config.replicaSeed);
+    }
+
+    for (CutSetOutput& out : m_vecOutputs) {
+
+      // additional cut sets go in subdirectories
+      // (workers don't write anything)
+      if (!m_isWorker) {
+        out.dir = out.cuts.name.empty() ? m_outDir : m_outDir -> mkdir(out.cuts.name.data());
+        out.dir -> cd();
+      }
+      out.nTot.assign(m_hist.vecTypeNames.size(), 0);
+      if (m_config.nReplicas > 0) {
+        out.replicas.Init(m_hist, m_config.nReplicas);
+      }
+
+      // create event histograms
+      for (auto evtNameAndTitle : m_hist.vecEvtNameAndTitles) {
+        out.vecHistEvt.push_back(
+          new TH1D(
+            evtNameAndTitle.first.data(),
+            evtNameAndTitle.second.data(),
+            m_hist.nNumBins,
+            m_hist.rNumBins.first,
+            m_hist.rNumBins.second
+          )
+        );
+      }
+
+      // create jet/lambda histograms: if using the fill
+      // table or rdataframe, these are only created once
+      // filling is done
+      if (m_config.useSparse) {
+        BookSparse(out);
+      } else if (m_config.useFillTable && !m_config.useRDataFrame) {
+        out.table.Init(m_hist);
+      } else if (!m_config.useRDataFrame) {
+        BookHists(out);
+      }
+
+      // create object tuple if needed
+      if (m_config.doTuple && !m_isWorker) {
+        InitTuple(out);
+      }
+
+      // worker histograms are only merged, never written,
+      // so keep them out of any directory
+      if (m_isWorker) {
+        for (auto hEvt : out.vecHistEvt) {
+          hEvt -> SetDirectory(NULL);
+        }
+        for (auto type : out.vecHist1D) {
+          for (auto h1D : type) {
+            if (h1D) h1D -> SetDirectory(NULL);
+          }
+        }
+        for (auto type : out.vecHist2D) {
+          for (auto var : type) {
+            for (auto h2D : var) {
+              if (h2D) h2D -> SetDirectory(NULL);
+            }
+          }
+        }
+      }
+    }  // end cut set loop
+    if (!m_isWorker) {
+      m_outDir -> cd();
+    }
+
+    // report how much is booked
+    if (!m_isWorker) {
+      ReportMemory();
+    }
+    cout << "    Initialized histograms for " << m_vecOutputs.size() << " cut set(s)." << endl;
+
+    // exit routine
+    return;
+
+  }  // end 'InitHists()'
+
+
+
+  void SReadLambdaJetTree::InitHistPolicy() {
+
+    // sumw2 sets how much each bin takes
+    TH1::SetDefaultSumw2(true);
+    TH2::SetDefaultSumw2(true);
+
+    // plan wanted histograms of every cut set, for
+    // every copy held at once
+    const uint64_t nSets   = m_config.vecCutSets.size() + 1;
+    const uint64_t nCopies = GetNHistCopies();
+    if ((m_config.histPolicy.budgetMB > 0.) && (nCopies > 1)) {
+      cout << "    Histogram budget covers " << nCopies << " copies of each histogram"
+           << (IsCheckpointOn() ? " (booked + checkpoint snapshot)." : " (merged + one per thread).")
+           << endl;
+    }
+    m_booker.SetPolicy(m_config.histPolicy);
+    for (size_t iType = 0; iType < m_hist.vecTypeNames.size(); iType++) {
+      for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
+        const uint64_t nCellsY = get<1>(m_hist.vecAxisDef[iVar]) + 2;
+        if (m_hist.IsWanted(iType, iVar)) {
+          m_booker.Plan(m_hist.vecBaseNames[iVar] + "_" + m_hist.vecTypeNames[iType], nCellsY * nSets * nCopies);
+        }
+        for (size_t iVs = 0; iVs < m_hist.vecVsMods.size(); iVs++) {
+          if (!m_hist.IsWanted2D(iType, iVar, iVs)) continue;
+          m_booker.Plan(
+            m_hist.vecBaseNames[iVar] + m_hist.vecVsMods[iVs] + "_" + m_hist.vecTypeNames[iType],
+            nCellsY * (get<1>(m_hist.vecVsDef[iVs]) + 2) * nSets * nCopies
+          );
+        }
+      }
+    }
+
+    // if over budget, sparse histograms only allocate
+    // bins that get filled (n.b. their size then grows
+    // with the no. of distinct bins filled, so the
+    // budget is no longer enforced)
+    const bool isInBudget = m_booker.Resolve();
+    if (!isInBudget && (m_config.histPolicy.overBudget == SHistPolicy::Sparse) && !m_config.useSparse) {
+      cout << "    Histograms over memory budget: switching to sparse histograms (size then depends on no. of bins filled, not on the budget)." << endl;
+      m_config.useSparse = true;
+    }
+
+    // the fill table and rdataframe results are always
+    // dense doubles, so with a budget the histograms
+    // booked above are filled directly in the event
+    // loop instead
+    if (m_config.histPolicy.budgetMB > 0.) {
+      if (m_config.useFillTable) {
+        cout << "    Histogram budget set: filling histograms directly instead of through fill table." << endl;
+        m_config.useFillTable = false;
+      }
+      if (m_config.useRDataFrame) {
+        cout << "    Histogram budget set: using event loop instead of RDataFrame." << endl;
+        m_config.useRDataFrame = false;
+      }
+    }
+    return;
+
+  }  // end 'InitHistPolicy()'
+
+
+
+  void SReadLambdaJetTree::ReportMemory() {
+
+    // count wanted histograms
+    uint64_t n1D = 0;
+    uint64_t n2D = 0;
+    for (size_t iType = 0; iType < m_hist.vecTypeNames.size(); iType++) {
+      for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
+        if (m_hist.IsWanted(iType, iVar)) {
+          ++n1D;
+        }
+        for (size_t iVs = 0; iVs < m_hist.vecVsMods.size(); iVs++) {
+          if (m_hist.IsWanted2D(iType, iVar, iVs)) ++n2D;
+        }
+      }
     }
 
+    // bytes per bin are set by the histogram policy,
+    // and each cut set has its own copy (the planned
+    // total also counts per-thread and checkpoint copies)
+    const uint64_t nSets   = m_vecOutputs.size();
+    const uint64_t nCopies = GetNHistCopies();
+    const double   nMBytes = (double) m_booker.GetBytes() / 1.0e6;
+    cout << "    Booking " << n1D << " 1d and " << n2D << " 2d jet/lambda histograms for "
+         << nSets << " cut set(s): ~" << nMBytes / nCopies << " MB"
+         << ((nCopies > 1) ? " (~" + to_string(nMBytes) + " MB over " + to_string(nCopies) + " copies)." : ".")
+         << endl;
+    if (m_config.useSparse) {
+      cout << "      Sparse histograms only allocate filled bins during event loop." << endl;
+    }
+    if (m_config.useFillTable && !m_config.useRDataFrame) {
+      uint64_t nTableBytes = 0;
+      for (const CutSetOutput& out : m_vecOutputs) {
+        nTableBytes += out.table.GetMemory();
+      }
+      cout << "      Fill tables use " << (double) nTableBytes / 1.0e6 << " MB during event loop." << endl;
+    }
+    if (m_config.nReplicas > 0) {
+      uint64_t nRepBytes = 0;
+      for (const CutSetOutput& out : m_vecOutputs) {
+        nRepBytes += sizeof(double) * (out.replicas.vecCounts.size() + out.replicas.vecTot.size());
+      }
+      cout << "      " << m_config.nReplicas << " bootstrap replicas use " << (double) nRepBytes / 1.0e6 << " MB." << endl;
+    }
+    return;
+
+  }  // end 'ReportMemory()'
+
+
+
+  void SReadLambdaJetTree::BookHists(CutSetOutput& out) {
+
     // create jet/lambda histograms
-    vecHist1D.resize( m_hist.vecTypeNames.size() );
-    vecHist2D.resize( m_hist.vecTypeNames.size() );
+    out.vecHist1D.resize( m_hist.vecTypeNames.size() );
+    out.vecHist2D.resize( m_hist.vecTypeNames.size() );
     for (size_t iType = 0; iType < m_hist.vecTypeNames.size(); iType++) {
 
       // loop over base variables
-      vecHist1D[iType].resize( m_hist.vecBaseNames.size() );
-      vecHist2D[iType].resize( m_hist.vecBaseNames.size() );
+      out.vecHist1D[iType].assign( m_hist.vecBaseNames.size(), NULL );
+      out.vecHist2D[iType].resize( m_hist.vecBaseNames.size() );
       for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
  
         // make 1d name and title
         const string sName1D  = m_hist.vecBaseNames[iVar] + "_" + m_hist.vecTypeNames[iType];
         const string sTitle1D = ";" + get<0>(m_hist.vecAxisDef[iVar]) + ";counts";
 
-        // create 1d histogram
-        vecHist1D[iType][iVar] = new TH1D(
-          sName1D.data(),
-          sTitle1D.data(),
-          get<1>(m_hist.vecAxisDef[iVar]),
-          get<2>(m_hist.vecAxisDef[iVar]).first,
-          get<2>(m_hist.vecAxisDef[iVar]).second
-        );
+        // create 1d histogram if wanted
+        if (m_hist.IsWanted(iType, iVar)) {
+          out.vecHist1D[iType][iVar] = m_booker.Make1D(
+            sName1D,
+            sTitle1D,
+            get<1>(m_hist.vecAxisDef[iVar]),
+            get<2>(m_hist.vecAxisDef[iVar]).first,
+            get<2>(m_hist.vecAxisDef[iVar]).second
+          );
+        }
 
         // loop over vs variables
-        vecHist2D[iType][iVar].resize( m_hist.vecVsMods.size() );
+        out.vecHist2D[iType][iVar].assign( m_hist.vecVsMods.size(), NULL );
         for (size_t iVs = 0; iVs < m_hist.vecVsMods.size(); iVs++) {
+
+          // skip if not wanted
+          if (!m_hist.IsWanted2D(iType, iVar, iVs)) continue;
  
           // make 2d name and title
           const string sName2D  = m_hist.vecBaseNames[iVar] + m_hist.vecVsMods[iVs] + "_" + m_hist.vecTypeNames[iType];
           const string sTitle2D = ";" + get<0>(m_hist.vecVsDef[iVs]) + ";" + get<0>(m_hist.vecAxisDef[iVar]) + ";counts";
 
           // create 2d histogram
-          vecHist2D[iType][iVar][iVs] = new TH2D(
-            sName2D.data(),
-            sTitle2D.data(),
+          out.vecHist2D[iType][iVar][iVs] = m_booker.Make2D(
+            sName2D,
+            sTitle2D,
             get<1>(m_hist.vecVsDef[iVs]),
             get<2>(m_hist.vecVsDef[iVs]).first,
             get<2>(m_hist.vecVsDef[iVs]).second,
@@ -221,534 +588,1884 @@ namespace SColdQcdCorrelatorAnalysis {
         }  // end vs loop
       }  // end variable loop
     }  // end type loop
-    cout << "    Initialized histograms." << endl;
-
-    // exit routine
     return;
 
-  }  // end 'InitHists()'
+  }  // end 'BookHists(CutSetOutput&)'
 
 
 
-  void SReadLambdaJetTree::DoAnalysis() {
+  void SReadLambdaJetTree::MaterializeHists() {
 
-    const int64_t nEvents = m_tInput -> GetEntries();
-    cout << "    Beginning event loop: " << nEvents << " to process" << endl;
+    // create histograms in each cut set's directory
+    // and copy in counts
+    for (CutSetOutput& out : m_vecOutputs) {
+      out.dir -> cd();
+      BookHists(out);
+      for (size_t iType = 0; iType < out.vecHist1D.size(); iType++) {
+        for (size_t iVar = 0; iVar < out.vecHist1D[iType].size(); iVar++) {
+          out.table.Materialize1D(iType, iVar, out.vecHist1D[iType][iVar]);
+          for (size_t iVs = 0; iVs < out.vecHist2D[iType][iVar].size(); iVs++) {
+            out.table.Materialize2D(iType, iVar, iVs, out.vecHist2D[iType][iVar][iVs]);
+          }
+        }
+      }
 
-    // for counting types
-    vector<uint64_t> nTot(m_hist.vecTypeNames.size(), 0);
-    vector<uint64_t> nEvt(m_hist.vecTypeNames.size(), 0);
+      // table is no longer needed
+      out.table.Clear();
+    }
+    m_outDir -> cd();
+    cout << "    Created histograms from fill table." << endl;
+    return;
 
-    int64_t nBytes = 0;
-    for (int64_t iEvt = 0; iEvt < nEvents; iEvt++) {
+  }  // end 'MaterializeHists()'
 
-      // grab event
-      const int64_t bytes = m_tInput -> GetEntry(iEvt);
-      if (bytes < 0) {
-        cerr << "WARNING: issue with event " << iEvt << "! Aborting event loop!" << endl;
-        break;
-      } else {
-        nBytes += bytes;
-      }
 
-      // announce progress
-      const int64_t iProg = iEvt + 1;
-      if (iProg == nEvents) {
-        cout << "      Processing entry " << iEvt << "/" << nEvents << "..." << endl;
-      } else {
-        cout << "      Processing entry " << iEvt << "/" << nEvents << "...\r" << flush;
-      }
 
-      // reset per-event counters
-      for (size_t iType = 0; iType < nEvt.size(); iType++) {
-        nEvt[iType] = 0;
-      }
+  void SReadLambdaJetTree::BookSparse(CutSetOutput& out) {
 
-      // get total no. of jets, lambdas in vectors
-      const size_t nVecJets = m_jetPt    -> size();
-      const size_t nVecLams = m_lambdaPt -> size();
+    // dimensions are (var, eta, E, pT, dphi, deta)
+    const size_t nVs  = m_hist.vecVsMods.size();
+    const size_t nDim = nVs + 1;
 
-      // identify highest pt jet
-      bool     foundTopPt = false;
-      double   ptTop      = 0.;
-      uint64_t iTopPt     = 0;
-      uint64_t nLamTop    = 0;
-      for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+    // create a sparse histogram for each (type, var)
+    // family with at least one wanted histogram
+    out.vecSparse.resize( m_hist.vecTypeNames.size() );
+    for (size_t iType = 0; iType < m_hist.vecTypeNames.size(); iType++) {
+      out.vecSparse[iType].assign( m_hist.vecBaseNames.size(), NULL );
+      for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
 
-        // make sure jet satisfies cuts
-        const bool isGoodJet = IsGoodJet(m_jetPt -> at(iJet), m_jetEta -> at(iJet));
-        if (!isGoodJet) continue; 
+        // skip if nothing in family is wanted
+        bool isWanted = m_hist.IsWanted(iType, iVar);
+        for (size_t iVs = 0; iVs < nVs; iVs++) {
+          isWanted = isWanted || m_hist.IsWanted2D(iType, iVar, iVs);
+        }
+        if (!isWanted) continue;
+
+        // collect axes
+        vector<int32_t> vecBins(nDim);
+        vector<double>  vecMin(nDim);
+        vector<double>  vecMax(nDim);
+        vecBins[0] = get<1>(m_hist.vecAxisDef[iVar]);
+        vecMin[0]  = get<2>(m_hist.vecAxisDef[iVar]).first;
+        vecMax[0]  = get<2>(m_hist.vecAxisDef[iVar]).second;
+        for (size_t iVs = 0; iVs < nVs; iVs++) {
+          vecBins[iVs + 1] = get<1>(m_hist.vecVsDef[iVs]);
+          vecMin[iVs + 1]  = get<2>(m_hist.vecVsDef[iVs]).first;
+          vecMax[iVs + 1]  = get<2>(m_hist.vecVsDef[iVs]).second;
+        }
 
-        // find associated lambda(s)
-        uint64_t nLamJet    = 0;
-        for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+        const string sName = m_hist.vecBaseNames[iVar] + "Sparse_" + m_hist.vecTypeNames[iType];
+        out.vecSparse[iType][iVar] = new THnSparseD(
+          sName.data(),
+          "",
+          nDim,
+          vecBins.data(),
+          vecMin.data(),
+          vecMax.data()
+        );
+      }  // end variable loop
+    }  // end type loop
+    return;
 
-          // check if lambda is associated
-          const bool isAssocLam = IsAssociatedLambda(m_lambdaJetID -> at(iLam), m_jetID -> at(iJet));
-          if (!isAssocLam) {
-            continue;
-          }
-          ++nLamJet;
-        }  // end lambda loop
+  }  // end 'BookSparse(CutSetOutput&)'
 
-        if (m_jetPt -> at(iJet) > ptTop) {
-          ptTop      = m_jetPt -> at(iJet);
-          iTopPt     = iJet;
-          nLamTop    = nLamJet;
-          foundTopPt = true;
-        }
-      }  // end 1st jet loop
 
-      // fill highest pt histograms
-      if (foundTopPt) {
-        Hist hTopPtJet = {
-          .eta  = m_jetEta -> at(iTopPt),
-          .ene  = m_jetE   -> at(iTopPt),
-          .pt   = m_jetPt  -> at(iTopPt),
-          .df   = 0.,
-          .dh   = 0.,
-          .dr   = 0.,
-          .z    = 1.,
-          .nlam = (double) nLamTop,
-          .ncst = (double) m_jetNCst -> at(iTopPt),
-          .plam = (double) nLamTop / (double) m_jetNCst -> at(iTopPt)
-        };
-        VsVar vsTopPtJet = {
-          .eta = m_jetEta -> at(iTopPt),
-          .ene = m_jetE   -> at(iTopPt),
-          .pt  = m_jetPt  -> at(iTopPt),
-          .df  = 0.,
-          .dh  = 0.
-        };
-        FillHist1D(Type::HJet, hTopPtJet);
-        FillHist2D(Type::HJet, hTopPtJet, vsTopPtJet);
-      }
 
-      // loop over lambdas
-      for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+  void SReadLambdaJetTree::ProjectSparse() {
 
-        // make sure lambda satisfies cuts
-        const bool isGoodLam = IsGoodLambda(m_lambdaPt -> at(iLam), m_lambdaEta -> at(iLam));
-        if (!isGoodLam) continue;
-
-        // do calculations
-        const double dfLam = GetDeltaPhi(m_lambdaPhi -> at(iLam), m_jetPhi -> at(iTopPt));
-        const double dhLam = GetDeltaEta(m_lambdaEta -> at(iLam), m_jetEta -> at(iTopPt)); 
-
-        // fill general lambda histograms
-        Hist hLambda = {
-          .eta  = m_lambdaEta    -> at(iLam),
-          .ene  = m_lambdaEnergy -> at(iLam),
-          .pt   = m_lambdaPt     -> at(iLam),
-          .df   = dfLam,
-          .dh   = dhLam,
-          .dr   = m_lambdaDr -> at(iLam),
-          .z    = m_lambdaZ  -> at(iLam),
-          .nlam = 1,
-          .ncst = 0,
-          .plam = 1
-        };
-        VsVar vsLambda = {
-          .eta = m_lambdaEta    -> at(iLam),
-          .ene = m_lambdaEnergy -> at(iLam),
-          .pt  = m_lambdaPt     -> at(iLam),
-          .df  = dfLam,
-          .dh  = dhLam
-        };
-        FillHist1D(Type::Lam, hLambda);
-        FillHist2D(Type::Lam, hLambda, vsLambda);
-        ++nEvt[Type::Lam];
-        ++nTot[Type::Lam];
+    // create wanted histograms in each cut set's directory
+    // and project sparse histograms onto them
+    for (CutSetOutput& out : m_vecOutputs) {
+      out.dir -> cd();
+      BookHists(out);
+      for (size_t iType = 0; iType < out.vecSparse.size(); iType++) {
+        for (size_t iVar = 0; iVar < out.vecSparse[iType].size(); iVar++) {
 
-        const bool isLeadLam = IsLeadingLambda(m_lambdaZ -> at(iLam));
-        if (isLeadLam) {
-          FillHist1D(Type::LLam, hLambda);
-          FillHist2D(Type::LLam, hLambda, vsLambda);
-          ++nEvt[Type::LLam];
-          ++nTot[Type::LLam];
-        }
-      }  // end lambda loop
+          THnSparseD* sparse = out.vecSparse[iType][iVar];
+          if (!sparse) continue;
 
-      // loop over jets
-      for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+          if (out.vecHist1D[iType][iVar]) {
+            TH1D* proj = sparse -> Projection(0);
+            out.vecHist1D[iType][iVar] -> Add(proj);
+            delete proj;
+          }
+          for (size_t iVs = 0; iVs < out.vecHist2D[iType][iVar].size(); iVs++) {
+            if (!out.vecHist2D[iType][iVar][iVs]) continue;
 
-        // make sure jet satisfies cuts
-        const bool isGoodJet = IsGoodJet(m_jetPt -> at(iJet), m_jetEta -> at(iJet));
-        if (!isGoodJet) continue;
-
-        // do calculations
-        const double dfJet = GetDeltaPhi(m_jetPhi -> at(iJet), m_jetPhi -> at(iTopPt));
-        const double dhJet = GetDeltaEta(m_jetEta -> at(iJet), m_jetEta -> at(iTopPt));
-
-        // find associated lambda(s)
-        bool     hasLambda  = false;
-        bool     hasLeadLam = false;
-        uint64_t nLamJet    = 0;
-        for (size_t iLam = 0; iLam < nVecLams; iLam++) {
-
-          // check if lambda is associated
-          const bool isAssocLam = IsAssociatedLambda(m_lambdaJetID -> at(iLam), m_jetID -> at(iJet));
-          if (!isAssocLam) {
-            continue;
-          } else {
-            hasLambda = true;
+            // n.b. y dimension comes first
+            TH2D* proj = sparse -> Projection(0, iVs + 1);
+            out.vecHist2D[iType][iVar][iVs] -> Add(proj);
+            delete proj;
           }
-          ++nLamJet;
 
-          // check if lambda is leading
-          const bool isLeadLam = IsLeadingLambda(m_lambdaZ -> at(iLam));
-          if (isLeadLam) hasLeadLam = true;
+          // sparse histogram is no longer needed
+          delete sparse;
+          out.vecSparse[iType][iVar] = NULL;
+        }
+      }
+    }  // end cut set loop
+    m_outDir -> cd();
+    cout << "    Projected sparse histograms." << endl;
+    return;
 
-        }  // end lambda loop
-        vecHistEvt.at(Evt::NLamJet) -> Fill(nLamJet);
-
-        // fill general jet histograms
-        Hist hJet = {
-          .eta  = m_jetEta -> at(iJet),
-          .ene  = m_jetE   -> at(iJet),
-          .pt   = m_jetPt  -> at(iJet),
-          .df   = dfJet,
-          .dh   = dhJet,
-          .dr   = 0.,
-          .z    = 1.,
-          .nlam = (double) nLamJet,
-          .ncst = (double) m_jetNCst -> at(iJet),
-          .plam = (double) nLamJet / (double) m_jetNCst -> at(iJet)
-        };
-        VsVar vsJet = {
-          .eta = m_jetEta -> at(iJet),
-          .ene = m_jetE   -> at(iJet),
-          .pt  = m_jetPt  -> at(iJet),
-          .df  = dfJet,
-          .dh  = dhJet
-        };
-        FillHist1D(Type::Jet, hJet);
-        FillHist2D(Type::Jet, hJet, vsJet);
-        ++nEvt[Type::Jet];
-        ++nTot[Type::Jet];
-
-        // if no lambdas, continue
-        //   otherwise fill hists
-        if (!hasLambda) {
-          continue;
-        } else {
-          FillHist1D(Type::LJet, hJet);
-          FillHist2D(Type::LJet, hJet, vsJet);
-          ++nEvt[Type::LJet];
-          ++nTot[Type::LJet];
-        }
-
-        // fill multi-lambda jet histogmras
-        if (nLamJet >= 2) {
+  }  // end 'ProjectSparse()'
 
-          // fill jet histograms
-          FillHist1D(Type::MLJet, hJet);
-          FillHist2D(Type::MLJet, hJet, vsJet);
-          ++nEvt[Type::MLJet];
-          ++nTot[Type::MLJet];
 
-          // loop over lambdas in jet
-          for (size_t iLam = 0; iLam < nVecLams; iLam++) {
 
-            // do calculations
-            const double dfLam = GetDeltaPhi(m_lambdaPhi -> at(iLam), m_jetPhi -> at(iTopPt));
-            const double dhLam = GetDeltaEta(m_lambdaEta -> at(iLam), m_jetEta -> at(iTopPt)); 
+  void SReadLambdaJetTree::DoAnalysis() {
 
-            // check if lambda is associated
-            const bool isAssocLam = IsAssociatedLambda(m_lambdaJetID -> at(iLam), m_jetID -> at(iJet));
-            if (!isAssocLam) {
-              continue;
-            }
+    // determine entry range
+    const int64_t nEntries = m_reader -> GetEntries();
+    const int64_t iStart   = m_firstEntry;
+    const int64_t iStop    = ((m_lastEntry < 0) || (m_lastEntry > nEntries)) ? nEntries : m_lastEntry;
+    cout << "    Beginning event loop: " << (iStop - iStart) << " to process" << endl;
+
+    // workers stay quiet
+    SProgressMeter progress;
+    progress.SetInterval(m_config.progressInterval);
+    progress.SetQuiet(m_isWorker);
+    progress.Start(iStop - iStart);
+
+    // checkpoints are written by a background thread
+    const bool doCheckpoint = IsCheckpointOn() && !m_isWorker;
+    if (doCheckpoint) {
+      ROOT::EnableThreadSafety();
+      m_checkpoint = new SCheckpointWriter();
+    }
+    auto     tLastCheckpoint = chrono::steady_clock::now();
+    uint64_t nSinceCheckpoint = 0;
+
+    // adds what's been read since the last push to the
+    // counts shared with the main thread
+    int64_t nEvtsPushed  = 0;
+    int64_t nBytesPushed = 0;
+    auto    pushProgress = [this, &progress, &nEvtsPushed, &nBytesPushed]() {
+      m_shared -> nEvts.fetch_add(progress.GetNDone() - nEvtsPushed, memory_order_relaxed);
+      m_shared -> nBytes.fetch_add(progress.GetNBytes() - nBytesPushed, memory_order_relaxed);
+      nEvtsPushed  = progress.GetNDone();
+      nBytesPushed = progress.GetNBytes();
+    };
+
+    for (int64_t iEvt = iStart; iEvt < iStop; iEvt++) {
 
-            // fill lambda in multi-lambda jet histograms
-            Hist hLamInMLJet = {
-              .eta  = m_lambdaEta    -> at(iLam),
-              .ene  = m_lambdaEnergy -> at(iLam),
-              .pt   = m_lambdaPt     -> at(iLam),
-              .df   = dfLam,
-              .dh   = dhLam,
-              .dr   = m_lambdaDr -> at(iLam),
-              .z    = m_lambdaZ  -> at(iLam),
-              .nlam = 1,
-              .ncst = 0,
-              .plam = 1
-            };
-            VsVar vsLamInMLJet = {
-              .eta = m_lambdaEta    -> at(iLam),
-              .ene = m_lambdaEnergy -> at(iLam),
-              .pt  = m_lambdaPt     -> at(iLam),
-              .df  = dfLam,
-              .dh  = dhLam
-            };
-            FillHist1D(Type::MLJetLam, hLamInMLJet);
-            FillHist2D(Type::MLJetLam, hLamInMLJet, vsLamInMLJet);
-          }  // end lambda loop
-        }  // end if (nLamJet >= 2)
-
-        // fill jet w/ leading lambda histograms
-        if (hasLeadLam) {
-          FillHist1D(Type::LLJet, hJet);
-          FillHist2D(Type::LLJet, hJet, vsJet);
-          ++nEvt[Type::LLJet];
-          ++nTot[Type::LLJet];
-        }
-      }  // end 2nd jet loop
-
-      // fill event histograms
-      vecHistEvt.at(Evt::NJet)      -> Fill(nEvt[Type::Jet]);
-      vecHistEvt.at(Evt::NTagJet)   -> Fill(nEvt[Type::LJet]);
-      vecHistEvt.at(Evt::NLeadJet)  -> Fill(nEvt[Type::LLJet]);
-      vecHistEvt.at(Evt::NMultiJet) -> Fill(nEvt[Type::MLJet]);
-      vecHistEvt.at(Evt::NLam)      -> Fill(nEvt[Type::Lam]);
-      vecHistEvt.at(Evt::NLeadLam)  -> Fill(nEvt[Type::LLam]);
+      // grab event
+      const int64_t bytes = m_reader -> GetEntry(iEvt);
+      if (bytes < 0) {
+        cerr << "WARNING: issue with event " << iEvt << "! Aborting event loop!" << endl;
+        break;
+      }
 
-    }  // end event loop
-    cout << "    Event loop finished!\n"
-         << "      nLambda          = " << nTot[Type::Lam]   << "\n"
-         << "      nLeadLambda      = " << nTot[Type::LLam]  << "\n"
-         << "      nJet             = " << nTot[Type::Jet]   << "\n"
-         << "      nTaggedJets      = " << nTot[Type::LJet]  << "\n"
-         << "      nLeadTagJets     = " << nTot[Type::LLJet] << "\n"
-         << "      nMultiLambdaJets = " << nTot[Type::MLJet]
-         << endl;
+      // announce progress (workers pass their counts
+      // on to the main thread in batches)
+      progress.Update(bytes);
+      if (m_shared && ((progress.GetNDone() % SharedProgress::NBatch) == 0)) {
+        pushProgress();
+      }
 
-    // exit routine
-    return;
+      // associate lambdas with jets once, then
+      // fill histograms for each set of cuts
+      BuildAssocIndex();
+      LoadEvent();
+      m_row.evt = m_entryOffset + iEvt;
+      if (m_config.nReplicas > 0) {
+        m_bootWeights.Generate(m_entryOffset + iEvt);
+      }
+      for (CutSetOutput& out : m_vecOutputs) {
+        ProcessEvent(out);
+      }
 
-  }  // end 'DoAnalysis()'
+      // copy event to skim if needed
+      if (m_config.doSkim) {
+        SkimEvent(iEvt);
+      }
 
+      // save state if a checkpoint is due: if the
+      // previous one is still being written, try
+      // again on the next event
+      if (doCheckpoint) {
+        ++nSinceCheckpoint;
 
+        const double dtCheckpoint = chrono::duration<double>(chrono::steady_clock::now() - tLastCheckpoint).count();
+        const bool   isDue        = (
+          ((m_config.checkpointEvents > 0) && (nSinceCheckpoint >= m_config.checkpointEvents)) ||
+          ((m_config.checkpointSeconds > 0.) && (dtCheckpoint >= m_config.checkpointSeconds))
+        );
+        if (isDue && !m_checkpoint -> IsBusy()) {
+          WriteCheckpoint(iEvt + 1, m_nEvtsRead + progress.GetNDone(), m_nBytesRead + progress.GetNBytes());
+          nSinceCheckpoint = 0;
+          tLastCheckpoint  = chrono::steady_clock::now();
+        }
+      }
 
-  void SReadLambdaJetTree::SetHistogramStyles() {
+    }  // end event loop
+    progress.Finish();
+    if (m_shared) {
+      pushProgress();
+    }
 
-    for (auto hEvt : vecHistEvt) {
-      hEvt -> SetLineStyle(m_config.defLineStyle);
-      hEvt -> SetLineColor(m_config.defHistColor);
-      hEvt -> SetFillStyle(m_config.defFillStyle);
-      hEvt -> SetFillColor(m_config.defHistColor);
-      hEvt -> SetMarkerStyle(m_config.defMarkStyle);
-      hEvt -> SetMarkerColor(m_config.defHistColor);
-      hEvt -> GetXaxis() -> CenterTitle(m_config.centerTitle);
-      hEvt -> GetXaxis() -> SetTitleFont(m_config.defHistFont);
-      hEvt -> GetXaxis() -> SetTitleSize(m_config.defTitleX);
-      hEvt -> GetXaxis() -> SetTitleOffset(m_config.defOffX);
-      hEvt -> GetXaxis() -> SetLabelSize(m_config.defLabelX);
-      hEvt -> GetYaxis() -> CenterTitle(m_config.centerTitle);
-      hEvt -> GetYaxis() -> SetTitleFont(m_config.defHistFont);
-      hEvt -> GetYaxis() -> SetTitleSize(m_config.defTitleY);
-      hEvt -> GetYaxis() -> SetTitleOffset(m_config.defOffY);
-      hEvt -> GetYaxis() -> SetLabelSize(m_config.defLabelY);
-    }
-    for (auto type : vecHist1D) {
-      for (auto h1D : type) {
-        h1D -> SetLineStyle(m_config.defLineStyle);
-        h1D -> SetLineColor(m_config.defHistColor);
-        h1D -> SetFillStyle(m_config.defFillStyle);
-        h1D -> SetFillColor(m_config.defHistColor);
-        h1D -> SetMarkerStyle(m_config.defMarkStyle);
-        h1D -> SetMarkerColor(m_config.defHistColor);
-        h1D -> GetXaxis() -> CenterTitle(m_config.centerTitle);
-        h1D -> GetXaxis() -> SetTitleFont(m_config.defHistFont);
-        h1D -> GetXaxis() -> SetTitleSize(m_config.defTitleX);
-        h1D -> GetXaxis() -> SetTitleOffset(m_config.defOffX);
-        h1D -> GetXaxis() -> SetLabelSize(m_config.defLabelX);
-        h1D -> GetYaxis() -> CenterTitle(m_config.centerTitle);
-        h1D -> GetYaxis() -> SetTitleFont(m_config.defHistFont);
-        h1D -> GetYaxis() -> SetTitleSize(m_config.defTitleY);
-        h1D -> GetYaxis() -> SetTitleOffset(m_config.defOffY);
-        h1D -> GetYaxis() -> SetLabelSize(m_config.defLabelY);
-      }
-    }
-    for (auto type : vecHist2D) {
-      for (auto var : type) {
-        for (auto h2D : var) {
-          h2D -> SetLineStyle(m_config.defLineStyle);
-          h2D -> SetLineColor(m_config.defHistColor);
-          h2D -> SetFillStyle(m_config.defFillStyle);
-          h2D -> SetFillColor(m_config.defHistColor);
-          h2D -> SetMarkerStyle(m_config.defMarkStyle);
-          h2D -> SetMarkerColor(m_config.defHistColor);
-          h2D -> GetXaxis() -> CenterTitle(m_config.centerTitle);
-          h2D -> GetXaxis() -> SetTitleFont(m_config.defHistFont);
-          h2D -> GetXaxis() -> SetTitleSize(m_config.defTitleX);
-          h2D -> GetXaxis() -> SetTitleOffset(m_config.defOffX);
-          h2D -> GetXaxis() -> SetLabelSize(m_config.defLabelX);
-          h2D -> GetYaxis() -> CenterTitle(m_config.centerTitle);
-          h2D -> GetYaxis() -> SetTitleFont(m_config.defHistFont);
-          h2D -> GetYaxis() -> SetTitleSize(m_config.defTitleY);
-          h2D -> GetYaxis() -> SetTitleOffset(m_config.defOffY);
-          h2D -> GetYaxis() -> SetLabelSize(m_config.defLabelY);
-          h2D -> GetZaxis() -> CenterTitle(m_config.centerTitle);
-          h2D -> GetZaxis() -> SetTitleFont(m_config.defHistFont);
-          h2D -> GetZaxis() -> SetTitleSize(m_config.defTitleZ);
-          h2D -> GetZaxis() -> SetTitleOffset(m_config.defOffZ);
-          h2D -> GetZaxis() -> SetLabelSize(m_config.defLabelZ);
-        }
+    // let last checkpoint finish
+    if (m_checkpoint) {
+      m_checkpoint -> Wait();
+      delete m_checkpoint;
+      m_checkpoint = NULL;
+    }
+
+    // keep track of what was read for threaded running
+    // (on top of anything read before resuming)
+    m_nEvtsRead  += progress.GetNDone();
+    m_nBytesRead += progress.GetNBytes();
+
+    // workers are summarized once merged
+    if (!m_isWorker) {
+      for (const CutSetOutput& out : m_vecOutputs) {
+        PrintSummary(out);
       }
     }
-    cout << "    Set histogram styles." << endl;
 
-    // exit internal routine
+    // exit routine
     return;
 
-  }  // end 'SetHistogramStyles()'
+  }  // end 'DoAnalysis()'
 
 
 
-  void SReadLambdaJetTree::SaveOutput() {
+  void SReadLambdaJetTree::ProcessEvent(CutSetOutput& out) {
 
-    m_outDir -> cd();
-    for (auto hEvt : vecHistEvt) {
-      hEvt -> Write();
-    }
-    for (auto type : vecHist1D) {
-      for (auto h1D : type) {
-        h1D -> Write();
-      }
+    // reset per-event counters
+    for (size_t iType = 0; iType < m_nEvt.size(); iType++) {
+      m_nEvt[iType] = 0;
     }
-    for (auto type : vecHist2D) {
-      for (auto var : type) {
-        for (auto h2D : var) {
-          h2D -> Write();
-        }
-      }
-    }
-    cout << "    Saved histograms." << endl;
 
-    // exit internal routine
-    return;
+    // get total no. of jets, lambdas in event
+    const size_t nVecJets = m_event.nJets;
+    const size_t nVecLams = m_event.nLams;
 
-  }  // end 'SaveOutput()'
+    // reset tuple flags
+    if (m_config.doTuple) {
+      m_vecLamFlags.assign(nVecLams, 0);
+      m_vecJetFlags.assign(nVecJets, 0);
+      m_vecLamRows.resize(nVecLams);
+      m_vecJetRows.resize(nVecJets);
+    }
+
+    // apply cuts to all jets and lambdas, identify
+    // highest pt jet, and get angles wrt it
+    const size_t iTop       = m_event.Select(out.cuts);
+    const bool   foundTopPt = (iTop < nVecJets);
+    const size_t iTopPt     = foundTopPt ? iTop : 0;
+    m_event.CalcDeltas(iTopPt);
+
+    // fill highest pt histograms
+    if (foundTopPt) {
+      Hist hTopPtJet = {
+        .eta  = m_event.jetEta[iTopPt],
+        .ene  = m_event.jetEne[iTopPt],
+        .pt   = m_event.jetPt[iTopPt],
+        .df   = 0.,
+        .dh   = 0.,
+        .dr   = 0.,
+        .z    = 1.,
+        .nlam = m_event.jetNLam[iTopPt],
+        .ncst = m_event.jetNCst[iTopPt],
+        .plam = m_event.jetPLam[iTopPt]
+      };
+      VsVar vsTopPtJet = {
+        .eta = m_event.jetEta[iTopPt],
+        .ene = m_event.jetEne[iTopPt],
+        .pt  = m_event.jetPt[iTopPt],
+        .df  = 0.,
+        .dh  = 0.
+      };
+      FillHists(out, Type::HJet, hTopPtJet, vsTopPtJet);
+      if (m_config.doTuple) TagForTuple(m_vecJetFlags, m_vecJetRows, iTopPt, Type::HJet, hTopPtJet);
+    }
+
+    // loop over lambdas
+    for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+
+      // make sure lambda satisfies cuts
+      if (!m_event.lamIsGood[iLam]) continue;
+
+      // fill general lambda histograms
+      Hist hLambda = {
+        .eta  = m_event.lamEta[iLam],
+        .ene  = m_event.lamEne[iLam],
+        .pt   = m_event.lamPt[iLam],
+        .df   = m_event.lamDf[iLam],
+        .dh   = m_event.lamDh[iLam],
+        .dr   = m_event.lamDr[iLam],
+        .z    = m_event.lamZ[iLam],
+        .nlam = 1,
+        .ncst = 0,
+        .plam = 1
+      };
+      VsVar vsLambda = {
+        .eta = m_event.lamEta[iLam],
+        .ene = m_event.lamEne[iLam],
+        .pt  = m_event.lamPt[iLam],
+        .df  = m_event.lamDf[iLam],
+        .dh  = m_event.lamDh[iLam]
+      };
+      FillHists(out, Type::Lam, hLambda, vsLambda);
+      if (m_config.doTuple) TagForTuple(m_vecLamFlags, m_vecLamRows, iLam, Type::Lam, hLambda);
+      ++m_nEvt[Type::Lam];
+      ++out.nTot[Type::Lam];
+
+      const bool isLeadLam = IsLeadingLambda(out.cuts, m_event.lamZ[iLam]);
+      if (isLeadLam) {
+        FillHists(out, Type::LLam, hLambda, vsLambda);
+        if (m_config.doTuple) TagForTuple(m_vecLamFlags, m_vecLamRows, iLam, Type::LLam, hLambda);
+        ++m_nEvt[Type::LLam];
+        ++out.nTot[Type::LLam];
+      }
+    }  // end lambda loop
+
+    // loop over jets
+    for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+
+      // make sure jet satisfies cuts
+      if (!m_event.jetIsGood[iJet]) continue;
+
+      // look up associated lambda(s)
+      const uint64_t nLamJet    = m_vecAssocStart[iJet + 1] - m_vecAssocStart[iJet];
+      const bool     hasLambda  = (nLamJet > 0);
+      const bool     hasLeadLam = hasLambda && IsLeadingLambda(out.cuts, m_vecJetMaxLamZ[iJet]);
+      out.vecHistEvt.at(Evt::NLamJet) -> Fill(nLamJet);
+
+      // fill general jet histograms
+      Hist hJet = {
+        .eta  = m_event.jetEta[iJet],
+        .ene  = m_event.jetEne[iJet],
+        .pt   = m_event.jetPt[iJet],
+        .df   = m_event.jetDf[iJet],
+        .dh   = m_event.jetDh[iJet],
+        .dr   = 0.,
+        .z    = 1.,
+        .nlam = m_event.jetNLam[iJet],
+        .ncst = m_event.jetNCst[iJet],
+        .plam = m_event.jetPLam[iJet]
+      };
+      VsVar vsJet = {
+        .eta = m_event.jetEta[iJet],
+        .ene = m_event.jetEne[iJet],
+        .pt  = m_event.jetPt[iJet],
+        .df  = m_event.jetDf[iJet],
+        .dh  = m_event.jetDh[iJet]
+      };
+      FillHists(out, Type::Jet, hJet, vsJet);
+      if (m_config.doTuple) TagForTuple(m_vecJetFlags, m_vecJetRows, iJet, Type::Jet, hJet);
+      ++m_nEvt[Type::Jet];
+      ++out.nTot[Type::Jet];
+
+      // if no lambdas, continue
+      //   otherwise fill hists
+      if (!hasLambda) {
+        continue;
+      } else {
+        FillHists(out, Type::LJet, hJet, vsJet);
+        if (m_config.doTuple) TagForTuple(m_vecJetFlags, m_vecJetRows, iJet, Type::LJet, hJet);
+        ++m_nEvt[Type::LJet];
+        ++out.nTot[Type::LJet];
+      }
+
+      // fill multi-lambda jet histogmras
+      if (nLamJet >= 2) {
+
+        // fill jet histograms
+        FillHists(out, Type::MLJet, hJet, vsJet);
+        if (m_config.doTuple) TagForTuple(m_vecJetFlags, m_vecJetRows, iJet, Type::MLJet, hJet);
+        ++m_nEvt[Type::MLJet];
+        ++out.nTot[Type::MLJet];
+
+        // loop over lambdas in jet
+        for (size_t iAssoc = m_vecAssocStart[iJet]; iAssoc < m_vecAssocStart[iJet + 1]; iAssoc++) {
+
+          // fill lambda in multi-lambda jet histograms
+          const size_t iLam        = m_vecAssocLam[iAssoc];
+          Hist         hLamInMLJet = {
+            .eta  = m_event.lamEta[iLam],
+            .ene  = m_event.lamEne[iLam],
+            .pt   = m_event.lamPt[iLam],
+            .df   = m_event.lamDf[iLam],
+            .dh   = m_event.lamDh[iLam],
+            .dr   = m_event.lamDr[iLam],
+            .z    = m_event.lamZ[iLam],
+            .nlam = 1,
+            .ncst = 0,
+            .plam = 1
+          };
+          VsVar vsLamInMLJet = {
+            .eta = m_event.lamEta[iLam],
+            .ene = m_event.lamEne[iLam],
+            .pt  = m_event.lamPt[iLam],
+            .df  = m_event.lamDf[iLam],
+            .dh  = m_event.lamDh[iLam]
+          };
+          FillHists(out, Type::MLJetLam, hLamInMLJet, vsLamInMLJet);
+          if (m_config.doTuple) TagForTuple(m_vecLamFlags, m_vecLamRows, iLam, Type::MLJetLam, hLamInMLJet);
+        }  // end lambda loop
+      }  // end if (nLamJet >= 2)
+
+      // fill jet w/ leading lambda histograms
+      if (hasLeadLam) {
+        FillHists(out, Type::LLJet, hJet, vsJet);
+        if (m_config.doTuple) TagForTuple(m_vecJetFlags, m_vecJetRows, iJet, Type::LLJet, hJet);
+        ++m_nEvt[Type::LLJet];
+        ++out.nTot[Type::LLJet];
+      }
+    }  // end 2nd jet loop
+
+    // fill event histograms
+    out.vecHistEvt.at(Evt::NJet)      -> Fill(m_nEvt[Type::Jet]);
+    out.vecHistEvt.at(Evt::NTagJet)   -> Fill(m_nEvt[Type::LJet]);
+    out.vecHistEvt.at(Evt::NLeadJet)  -> Fill(m_nEvt[Type::LLJet]);
+    out.vecHistEvt.at(Evt::NMultiJet) -> Fill(m_nEvt[Type::MLJet]);
+    out.vecHistEvt.at(Evt::NLam)      -> Fill(m_nEvt[Type::Lam]);
+    out.vecHistEvt.at(Evt::NLeadLam)  -> Fill(m_nEvt[Type::LLam]);
+
+    // write tagged objects to tuple
+    if (m_config.doTuple) {
+      FillTuple(out);
+    }
+    return;
+
+  }  // end 'ProcessEvent(CutSetOutput&)'
+
+
+
+  void SReadLambdaJetTree::DoParallelAnalysis() {
+
+    // make sure root is ready for threads
+    ROOT::EnableThreadSafety();
+
+    // get no. of entries in selected range
+    const int64_t  nEntries = m_range.GetNEntries();
+    const uint64_t nThreads = min((int64_t) m_config.nThreads, max(nEntries, (int64_t) 1));
+
+    // create workers: each has its own input chain and histograms
+    SReadLambdaJetTreeConfig cfgWorker = m_config;
+    cfgWorker.nThreads = 1;
+    cfgWorker.inFormat = m_reader -> IsNTuple() ? "rntuple" : "ttree";
+
+    // files can only be split up if reading whole chain
+    const bool isFullChain = (nEntries == m_reader -> GetEntries());
+    if (m_config.splitByFile && !isFullChain) {
+      cout << "    Only part of the input is selected: splitting threads by entry instead of by file." << endl;
+    }
+
+    if (m_config.splitByFile && isFullChain) {
+
+      // give each thread a contiguous group of files,
+      // balancing the no. of entries
+      const int32_t nFiles  = m_reader -> GetNFiles();
+      const uint64_t  nGroups = min(nThreads, (uint64_t) max(nFiles, 1));
+      cout << "    Splitting " << nFiles << " files (" << nEntries << " entries) across " << nGroups << " threads." << endl;
+
+      int32_t iFile = 0;
+      for (uint64_t iGroup = 0; iGroup < nGroups; iGroup++) {
+
+        // fill group up to its share of entries, leaving
+        // at least one file for each remaining group
+        const int64_t target = (nEntries * (int64_t) (iGroup + 1)) / (int64_t) nGroups;
+        const int32_t nLeft  = (int32_t) (nGroups - iGroup - 1);
+
+        const int32_t iFirstFile = iFile;
+        cfgWorker.inFileName = "";
+        cfgWorker.vecInFiles.clear();
+        do {
+          cfgWorker.vecInFiles.push_back(m_reader -> GetFile(iFile));
+          ++iFile;
+        } while ((iFile < nFiles - nLeft) && ((m_reader -> GetFileOffset(iFile) < target) || (iGroup == nGroups - 1)));
+
+        SReadLambdaJetTree* worker = new SReadLambdaJetTree();
+        worker -> SetConfig(cfgWorker);
+        worker -> SetHistDef(m_hist);
+        worker -> m_booker = m_booker;
+        worker -> SetVerbosity(m_verbosity);
+        worker -> SetDebug(m_isDebugOn);
+        worker -> m_isWorker    = true;
+        worker -> m_entryOffset = m_reader -> GetFileOffset(iFirstFile);
+        m_vecWorkers.push_back(worker);
+      }
+
+    } else {
+
+      // split entries evenly across threads
+      const int64_t nPerThr = nEntries / nThreads;
+      const int64_t nExtra  = nEntries % nThreads;
+      cout << "    Splitting " << nEntries << " entries across " << nThreads << " threads." << endl;
+
+      int64_t iFirst = m_range.first;
+      for (uint64_t iThr = 0; iThr < nThreads; iThr++) {
+        const int64_t nThrEntries = nPerThr + (((int64_t) iThr < nExtra) ? 1 : 0);
+
+        SReadLambdaJetTree* worker = new SReadLambdaJetTree();
+        worker -> SetConfig(cfgWorker);
+        worker -> SetHistDef(m_hist);
+        worker -> m_booker = m_booker;
+        worker -> SetVerbosity(m_verbosity);
+        worker -> SetDebug(m_isDebugOn);
+        worker -> m_isWorker   = true;
+        worker -> m_firstEntry = iFirst;
+        worker -> m_lastEntry  = iFirst + nThrEntries;
+        m_vecWorkers.push_back(worker);
+        iFirst += nThrEntries;
+      }
+    }
+
+    // run workers: each passes its counts on through
+    // shared counters
+    SProgressMeter progress;
+    progress.SetInterval(m_config.progressInterval);
+    progress.Start(nEntries);
+
+    SharedProgress shared;
+    vector<thread> vecThreads;
+    for (SReadLambdaJetTree* worker : m_vecWorkers) {
+      worker -> m_shared = &shared;
+      vecThreads.emplace_back(
+        [worker, &shared]() {
+          worker -> InitInput();
+          worker -> InitTree();
+          worker -> InitHists();
+          worker -> DoAnalysis();
+          ++shared.nFinished;
+        }
+      );
+    }
+
+    // update progress on the interval while waiting
+    while (shared.nFinished < m_vecWorkers.size()) {
+      this_thread::sleep_for(chrono::milliseconds(100));
+      progress.Update(shared.nEvts.load(), shared.nBytes.load());
+    }
+    for (thread& thr : vecThreads) {
+      thr.join();
+    }
+    cout << "    All threads finished." << endl;
+
+    // report total throughput
+    int64_t nEvtsRead  = 0;
+    int64_t nBytesRead = 0;
+    for (SReadLambdaJetTree* worker : m_vecWorkers) {
+      nEvtsRead  += worker -> m_nEvtsRead;
+      nBytesRead += worker -> m_nBytesRead;
+    }
+    progress.Set(nEvtsRead, nBytesRead);
+    progress.Finish();
+    m_nEvtsRead  = progress.GetNDone();
+    m_nBytesRead = progress.GetNBytes();
+
+    // exit routine
+    return;
+
+  }  // end 'DoParallelAnalysis()'
+
+
+
+  void SReadLambdaJetTree::DoRDataFrameAnalysis() {
+
+    // turn on implicit multithreading if needed
+    if (m_config.nThreads > 1) {
+      ROOT::EnableImplicitMT(m_config.nThreads);
+    }
+
+    // build data frame over the selected range of the
+    // chained input files
+    vector<string> vecFiles;
+    for (int32_t iFile = 0; iFile < m_tInput -> GetListOfFiles() -> GetEntries(); iFile++) {
+      vecFiles.push_back(m_tInput -> GetListOfFiles() -> At(iFile) -> GetTitle());
+    }
+
+    ROOT::RDF::Experimental::RDatasetSpec spec;
+    spec.AddSample({"input", m_config.inTreeName, vecFiles});
+    spec.WithGlobalRange({m_range.first, m_range.last});
+    ROOT::RDataFrame frame(spec);
+    cout << "    Beginning RDataFrame event loop: " << m_range.GetNEntries() << " to process" << endl;
+
+    // select objects for all cut sets at once
+    ROOT::RDF::RNode node = frame.Define(
+      "rows",
+      [this](
+        const ROOT::RVec<uint64_t>& jetNCst,
+        const ROOT::RVec<uint64_t>& jetID,
+        const ROOT::RVec<double>&   jetE,
+        const ROOT::RVec<double>&   jetPt,
+        const ROOT::RVec<double>&   jetEta,
+        const ROOT::RVec<double>&   jetPhi,
+        const ROOT::RVec<int>&      lamJetID,
+        const ROOT::RVec<double>&   lamZ,
+        const ROOT::RVec<double>&   lamDr,
+        const ROOT::RVec<double>&   lamE,
+        const ROOT::RVec<double>&   lamPt,
+        const ROOT::RVec<double>&   lamEta,
+        const ROOT::RVec<double>&   lamPhi
+      ) {
+        return SelectEvent(jetNCst, jetID, jetE, jetPt, jetEta, jetPhi, lamJetID, lamZ, lamDr, lamE, lamPt, lamEta, lamPhi);
+      },
+      {
+        "JetNCst",
+        "JetID",
+        "JetE",
+        "JetPt",
+        "JetEta",
+        "JetPhi",
+        "LambdaJetID",
+        "LambdaZ",
+        "LambdaDr",
+        "LambdaEnergy",
+        "LambdaPt",
+        "LambdaEta",
+        "LambdaPhi"
+      }
+    );
+
+    // event histogram <--> type counted
+    const vector<pair<int, int>> vecEvtTypes = {
+      {Evt::NJet,      Type::Jet},
+      {Evt::NTagJet,   Type::LJet},
+      {Evt::NLeadJet,  Type::LLJet},
+      {Evt::NMultiJet, Type::MLJet},
+      {Evt::NLam,      Type::Lam},
+      {Evt::NLeadLam,  Type::LLam}
+    };
+
+    // book results: columns are only defined if used,
+    // and only wanted histograms are booked
+    const size_t nSets  = m_vecOutputs.size();
+    const size_t nTypes = m_hist.vecTypeNames.size();
+    const size_t nVars  = m_hist.vecBaseNames.size();
+    const size_t nVs    = m_hist.vecVsMods.size();
+
+    vector<vector<ROOT::RDF::RResultPtr<TH1D>>>                 vecResEvt(nSets);
+    vector<vector<ROOT::RDF::RResultPtr<double>>>               vecResTot(nSets);
+    vector<vector<vector<ROOT::RDF::RResultPtr<TH1D>>>>         vecRes1D(nSets);
+    vector<vector<vector<vector<ROOT::RDF::RResultPtr<TH2D>>>>> vecRes2D(nSets);
+    for (size_t iSet = 0; iSet < nSets; iSet++) {
+
+      const string sSet = "set" + to_string(iSet) + "_";
+
+      // event histograms and totals
+      vecResEvt[iSet].resize(m_hist.vecEvtNameAndTitles.size());
+      vecResTot[iSet].resize(nTypes);
+      for (const auto& [iEvt, iType] : vecEvtTypes) {
+        const string col = sSet + "n" + m_hist.vecTypeNames[iType];
+        node = node.Define(col, [iSet, iType = iType](const vector<EventRows>& rows) {return (double) rows[iSet].nEvt[iType];}, {"rows"});
+        vecResEvt[iSet][iEvt] = node.Histo1D<double>(
+          {
+            (sSet + m_hist.vecEvtNameAndTitles[iEvt].first).data(),
+            m_hist.vecEvtNameAndTitles[iEvt].second.data(),
+            (int) m_hist.nNumBins,
+            m_hist.rNumBins.first,
+            m_hist.rNumBins.second
+          },
+          col
+        );
+        vecResTot[iSet][iType] = node.Sum<double>(col);
+      }
+
+      const string colNLamJet = sSet + "nLamJet";
+      node = node.Define(colNLamJet, [iSet](const vector<EventRows>& rows) {return ROOT::RVec<double>(rows[iSet].vecNLamJet.begin(), rows[iSet].vecNLamJet.end());}, {"rows"});
+      vecResEvt[iSet][Evt::NLamJet] = node.Histo1D<ROOT::RVec<double>>(
+        {
+          (sSet + m_hist.vecEvtNameAndTitles[Evt::NLamJet].first).data(),
+          m_hist.vecEvtNameAndTitles[Evt::NLamJet].second.data(),
+          (int) m_hist.nNumBins,
+          m_hist.rNumBins.first,
+          m_hist.rNumBins.second
+        },
+        colNLamJet
+      );
+
+      // jet/lambda histograms
+      vecRes1D[iSet].resize(nTypes);
+      vecRes2D[iSet].resize(nTypes);
+      for (size_t iType = 0; iType < nTypes; iType++) {
+
+        // one column per variable, in same order as
+        // histogram definitions
+        vector<string> vecCols(nVars);
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          vecCols[iVar] = sSet + m_hist.vecBaseNames[iVar] + "_" + m_hist.vecTypeNames[iType];
+          node = node.Define(
+            vecCols[iVar],
+            [iSet, iType, iVar](const vector<EventRows>& rows) {
+              ROOT::RVec<double> vals;
+              vals.reserve(rows[iSet].vecRows[iType].size());
+              for (const Hist& hist : rows[iSet].vecRows[iType]) {
+                const double vars[] = {hist.eta, hist.ene, hist.pt, hist.df, hist.dh, hist.dr, hist.z, hist.nlam, hist.ncst, hist.plam};
+                vals.push_back(vars[iVar]);
+              }
+              return vals;
+            },
+            {"rows"}
+          );
+        }
+
+        // vs variables are the first variables
+        vecRes1D[iSet][iType].resize(nVars);
+        vecRes2D[iSet][iType].resize(nVars);
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          const string sTitle1D = ";" + get<0>(m_hist.vecAxisDef[iVar]) + ";counts";
+          if (m_hist.IsWanted(iType, iVar)) {
+            vecRes1D[iSet][iType][iVar] = node.Histo1D<ROOT::RVec<double>>(
+              {
+                vecCols[iVar].data(),
+                sTitle1D.data(),
+                (int) get<1>(m_hist.vecAxisDef[iVar]),
+                get<2>(m_hist.vecAxisDef[iVar]).first,
+                get<2>(m_hist.vecAxisDef[iVar]).second
+              },
+              vecCols[iVar]
+            );
+          }
+
+          vecRes2D[iSet][iType][iVar].resize(nVs);
+          for (size_t iVs = 0; iVs < nVs; iVs++) {
+            if (!m_hist.IsWanted2D(iType, iVar, iVs)) continue;
+
+            const string sName2D  = vecCols[iVar] + m_hist.vecVsMods[iVs];
+            const string sTitle2D = ";" + get<0>(m_hist.vecVsDef[iVs]) + ";" + get<0>(m_hist.vecAxisDef[iVar]) + ";counts";
+            vecRes2D[iSet][iType][iVar][iVs] = node.Histo2D<ROOT::RVec<double>, ROOT::RVec<double>>(
+              {
+                sName2D.data(),
+                sTitle2D.data(),
+                (int) get<1>(m_hist.vecVsDef[iVs]),
+                get<2>(m_hist.vecVsDef[iVs]).first,
+                get<2>(m_hist.vecVsDef[iVs]).second,
+                (int) get<1>(m_hist.vecAxisDef[iVar]),
+                get<2>(m_hist.vecAxisDef[iVar]).first,
+                get<2>(m_hist.vecAxisDef[iVar]).second
+              },
+              vecCols[iVs],
+              vecCols[iVar]
+            );
+          }  // end vs loop
+        }  // end variable loop
+      }  // end type loop
+    }  // end cut set loop
+
+    // run event loop (triggered by first access to
+    // a result) and count entries
+    auto resCount = frame.Count();
+    m_nEvtsRead   = *resCount;
+
+    // copy results into output histograms: adding to
+    // empty histograms keeps contents and stats intact
+    for (size_t iSet = 0; iSet < nSets; iSet++) {
+      CutSetOutput& out = m_vecOutputs[iSet];
+      for (size_t iEvt = 0; iEvt < out.vecHistEvt.size(); iEvt++) {
+        out.vecHistEvt[iEvt] -> Add(vecResEvt[iSet][iEvt].GetPtr());
+      }
+      for (const auto& [iEvt, iType] : vecEvtTypes) {
+        out.nTot[iType] = (uint64_t) *vecResTot[iSet][iType];
+      }
+
+      out.dir -> cd();
+      BookHists(out);
+      for (size_t iType = 0; iType < nTypes; iType++) {
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          if (out.vecHist1D[iType][iVar]) {
+            out.vecHist1D[iType][iVar] -> Add(vecRes1D[iSet][iType][iVar].GetPtr());
+          }
+          for (size_t iVs = 0; iVs < nVs; iVs++) {
+            if (!out.vecHist2D[iType][iVar][iVs]) continue;
+            out.vecHist2D[iType][iVar][iVs] -> Add(vecRes2D[iSet][iType][iVar][iVs].GetPtr());
+          }
+        }
+      }
+      PrintSummary(out);
+    }  // end cut set loop
+    m_outDir -> cd();
+
+    // exit routine
+    return;
+
+  }  // end 'DoRDataFrameAnalysis()'
+
+
+
+  vector<SReadLambdaJetTree::EventRows> SReadLambdaJetTree::SelectEvent(
+    const ROOT::RVec<uint64_t>& jetNCst,
+    const ROOT::RVec<uint64_t>& jetID,
+    const ROOT::RVec<double>&   jetE,
+    const ROOT::RVec<double>&   jetPt,
+    const ROOT::RVec<double>&   jetEta,
+    const ROOT::RVec<double>&   jetPhi,
+    const ROOT::RVec<int>&      lamJetID,
+    const ROOT::RVec<double>&   lamZ,
+    const ROOT::RVec<double>&   lamDr,
+    const ROOT::RVec<double>&   lamE,
+    const ROOT::RVec<double>&   lamPt,
+    const ROOT::RVec<double>&   lamEta,
+    const ROOT::RVec<double>&   lamPhi
+  ) const {
+
+    const size_t nVecJets = jetPt.size();
+    const size_t nVecLams = lamPt.size();
+
+    // associate lambdas with jets (as in BuildAssocIndex,
+    // but local so that it can run on several threads)
+    unordered_map<int, size_t> mapJetIDOntoIndex;
+    for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+      mapJetIDOntoIndex.emplace((int) jetID.at(iJet), iJet);
+    }
+
+    vector<vector<size_t>> vecJetLams(nVecJets);
+    vector<double>         vecJetMaxLamZ(nVecJets, -1.);
+    for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+      auto itJet = mapJetIDOntoIndex.find(lamJetID.at(iLam));
+      if (itJet == mapJetIDOntoIndex.end()) continue;
+
+      const size_t iJet = itJet -> second;
+      if (!IsAssociatedLambda(lamJetID.at(iLam), jetID.at(iJet))) continue;
+
+      vecJetLams[iJet].push_back(iLam);
+      vecJetMaxLamZ[iJet] = max(vecJetMaxLamZ[iJet], lamZ.at(iLam));
+    }
+
+    // then collect objects for each cut set
+    vector<EventRows> vecRows(m_vecOutputs.size());
+    for (size_t iSet = 0; iSet < m_vecOutputs.size(); iSet++) {
+
+      const SReadLambdaJetTreeCuts& cuts = m_vecOutputs[iSet].cuts;
+      EventRows&                    rows = vecRows[iSet];
+      rows.vecRows.resize(m_hist.vecTypeNames.size());
+      rows.nEvt.assign(m_hist.vecTypeNames.size(), 0);
+
+      // identify highest pt jet
+      bool     foundTopPt = false;
+      double   ptTop      = 0.;
+      uint64_t iTopPt     = 0;
+      for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+        if (!IsGoodJet(cuts, jetPt.at(iJet), jetEta.at(iJet))) continue;
+        if (jetPt.at(iJet) > ptTop) {
+          ptTop      = jetPt.at(iJet);
+          iTopPt     = iJet;
+          foundTopPt = true;
+        }
+      }
+      if (foundTopPt) {
+        const uint64_t nLamTop = vecJetLams[iTopPt].size();
+        rows.vecRows[Type::HJet].push_back({
+          .eta  = jetEta.at(iTopPt),
+          .ene  = jetE.at(iTopPt),
+          .pt   = jetPt.at(iTopPt),
+          .df   = 0.,
+          .dh   = 0.,
+          .dr   = 0.,
+          .z    = 1.,
+          .nlam = (double) nLamTop,
+          .ncst = (double) jetNCst.at(iTopPt),
+          .plam = (double) nLamTop / (double) jetNCst.at(iTopPt)
+        });
+      }
+
+      // angles are wrt the highest pt jet (or the 1st jet
+      // if none pass), and wrt 0 if there are no jets,
+      // same as SReadLambdaJetTreeEvent::CalcDeltas
+      const double phiRef = (iTopPt < nVecJets) ? jetPhi[iTopPt] : 0.;
+      const double etaRef = (iTopPt < nVecJets) ? jetEta[iTopPt] : 0.;
+
+      // lambdas
+      for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+        if (!IsGoodLambda(cuts, lamPt.at(iLam), lamEta.at(iLam))) continue;
+
+        const Hist hLambda = {
+          .eta  = lamEta.at(iLam),
+          .ene  = lamE.at(iLam),
+          .pt   = lamPt.at(iLam),
+          .df   = GetDeltaPhi(lamPhi.at(iLam), phiRef),
+          .dh   = GetDeltaEta(lamEta.at(iLam), etaRef),
+          .dr   = lamDr.at(iLam),
+          .z    = lamZ.at(iLam),
+          .nlam = 1,
+          .ncst = 0,
+          .plam = 1
+        };
+        rows.vecRows[Type::Lam].push_back(hLambda);
+        ++rows.nEvt[Type::Lam];
+        if (IsLeadingLambda(cuts, lamZ.at(iLam))) {
+          rows.vecRows[Type::LLam].push_back(hLambda);
+          ++rows.nEvt[Type::LLam];
+        }
+      }
+
+      // jets
+      for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+        if (!IsGoodJet(cuts, jetPt.at(iJet), jetEta.at(iJet))) continue;
+
+        const uint64_t nLamJet = vecJetLams[iJet].size();
+        rows.vecNLamJet.push_back(nLamJet);
+
+        const Hist hJet = {
+          .eta  = jetEta.at(iJet),
+          .ene  = jetE.at(iJet),
+          .pt   = jetPt.at(iJet),
+          .df   = GetDeltaPhi(jetPhi.at(iJet), phiRef),
+          .dh   = GetDeltaEta(jetEta.at(iJet), etaRef),
+          .dr   = 0.,
+          .z    = 1.,
+          .nlam = (double) nLamJet,
+          .ncst = (double) jetNCst.at(iJet),
+          .plam = (double) nLamJet / (double) jetNCst.at(iJet)
+        };
+        rows.vecRows[Type::Jet].push_back(hJet);
+        ++rows.nEvt[Type::Jet];
+        if (nLamJet == 0) continue;
+
+        rows.vecRows[Type::LJet].push_back(hJet);
+        ++rows.nEvt[Type::LJet];
+
+        // multi-lambda jets and their lambdas
+        if (nLamJet >= 2) {
+          rows.vecRows[Type::MLJet].push_back(hJet);
+          ++rows.nEvt[Type::MLJet];
+          for (const size_t iLam : vecJetLams[iJet]) {
+            rows.vecRows[Type::MLJetLam].push_back({
+              .eta  = lamEta.at(iLam),
+              .ene  = lamE.at(iLam),
+              .pt   = lamPt.at(iLam),
+              .df   = GetDeltaPhi(lamPhi.at(iLam), phiRef),
+              .dh   = GetDeltaEta(lamEta.at(iLam), etaRef),
+              .dr   = lamDr.at(iLam),
+              .z    = lamZ.at(iLam),
+              .nlam = 1,
+              .ncst = 0,
+              .plam = 1
+            });
+          }
+        }
+
+        // jets with a leading lambda
+        if (IsLeadingLambda(cuts, vecJetMaxLamZ[iJet])) {
+          rows.vecRows[Type::LLJet].push_back(hJet);
+          ++rows.nEvt[Type::LLJet];
+        }
+      }  // end jet loop
+    }  // end cut set loop
+    return vecRows;
+
+  }  // end 'SelectEvent(RVec<uint64_t>&, ...)'
+
+
+
+  void SReadLambdaJetTree::MergeWorkers() {
+
+    // add worker histograms and counters to main ones
+    for (SReadLambdaJetTree* worker : m_vecWorkers) {
+      for (size_t iSet = 0; iSet < m_vecOutputs.size(); iSet++) {
+        CutSetOutput& out  = m_vecOutputs[iSet];
+        CutSetOutput& wOut = worker -> m_vecOutputs[iSet];
+        for (size_t iEvt = 0; iEvt < out.vecHistEvt.size(); iEvt++) {
+          out.vecHistEvt[iEvt] -> Add(wOut.vecHistEvt[iEvt]);
+        }
+        for (size_t iType = 0; iType < out.nTot.size(); iType++) {
+          out.nTot[iType] += wOut.nTot[iType];
+        }
+        if (m_config.useFillTable) {
+          out.table.Add(wOut.table);
+        }
+        if (m_config.nReplicas > 0) {
+          out.replicas.Add(wOut.replicas);
+        }
+        for (size_t iType = 0; iType < out.vecSparse.size(); iType++) {
+          for (size_t iVar = 0; iVar < out.vecSparse[iType].size(); iVar++) {
+            if (!out.vecSparse[iType][iVar]) continue;
+            out.vecSparse[iType][iVar] -> Add(wOut.vecSparse[iType][iVar]);
+          }
+        }
+        for (size_t iType = 0; iType < out.vecHist1D.size(); iType++) {
+          for (size_t iVar = 0; iVar < out.vecHist1D[iType].size(); iVar++) {
+            if (out.vecHist1D[iType][iVar]) {
+              out.vecHist1D[iType][iVar] -> Add(wOut.vecHist1D[iType][iVar]);
+            }
+            for (size_t iVs = 0; iVs < out.vecHist2D[iType][iVar].size(); iVs++) {
+              if (!out.vecHist2D[iType][iVar][iVs]) continue;
+              out.vecHist2D[iType][iVar][iVs] -> Add(wOut.vecHist2D[iType][iVar][iVs]);
+            }
+          }
+        }
+      }  // end cut set loop
+    }  // end worker loop
+
+    // then clean up workers
+    for (SReadLambdaJetTree* worker : m_vecWorkers) {
+      for (CutSetOutput& wOut : worker -> m_vecOutputs) {
+        for (auto hEvt : wOut.vecHistEvt) {
+          delete hEvt;
+        }
+        for (auto type : wOut.vecHist1D) {
+          for (auto h1D : type) {
+            delete h1D;
+          }
+        }
+        for (auto type : wOut.vecHist2D) {
+          for (auto var : type) {
+            for (auto h2D : var) {
+              delete h2D;
+            }
+          }
+        }
+        for (auto type : wOut.vecSparse) {
+          for (auto sparse : type) {
+            delete sparse;
+          }
+        }
+      }
+      worker -> CloseInput();
+      delete worker;
+    }
+    m_vecWorkers.clear();
+    cout << "    Merged histograms from worker threads." << endl;
+
+    // announce totals
+    for (const CutSetOutput& out : m_vecOutputs) {
+      PrintSummary(out);
+    }
+    return;
+
+  }  // end 'MergeWorkers()'
+
+
+
+  void SReadLambdaJetTree::PrintSummary(const CutSetOutput& out) {
+
+    const string sSet = out.cuts.name.empty() ? "" : " (" + out.cuts.name + ")";
+    cout << "    Event loop finished" << sSet << "!\n"
+         << "      nLambda          = " << out.nTot[Type::Lam]   << "\n"
+         << "      nLeadLambda      = " << out.nTot[Type::LLam]  << "\n"
+         << "      nJet             = " << out.nTot[Type::Jet]   << "\n"
+         << "      nTaggedJets      = " << out.nTot[Type::LJet]  << "\n"
+         << "      nLeadTagJets     = " << out.nTot[Type::LLJet] << "\n"
+         << "      nMultiLambdaJets = " << out.nTot[Type::MLJet]
+         << endl;
+    return;
+
+  }  // end 'PrintSummary(CutSetOutput&)'
+
+
+
+  void SReadLambdaJetTree::SetHistogramStyles() {
+
+    // set style once on a template...
+    TH2D hStyle("hStyle", "", 1, 0., 1., 1, 0., 1.);
+    hStyle.SetDirectory(NULL);
+    hStyle.SetLineStyle(m_config.defLineStyle);
+    hStyle.SetLineColor(m_config.defHistColor);
+    hStyle.SetFillStyle(m_config.defFillStyle);
+    hStyle.SetFillColor(m_config.defHistColor);
+    hStyle.SetMarkerStyle(m_config.defMarkStyle);
+    hStyle.SetMarkerColor(m_config.defHistColor);
+    hStyle.GetXaxis() -> SetTitleFont(m_config.defHistFont);
+    hStyle.GetXaxis() -> SetTitleSize(m_config.defTitleX);
+    hStyle.GetXaxis() -> SetTitleOffset(m_config.defOffX);
+    hStyle.GetXaxis() -> SetLabelSize(m_config.defLabelX);
+    hStyle.GetYaxis() -> SetTitleFont(m_config.defHistFont);
+    hStyle.GetYaxis() -> SetTitleSize(m_config.defTitleY);
+    hStyle.GetYaxis() -> SetTitleOffset(m_config.defOffY);
+    hStyle.GetYaxis() -> SetLabelSize(m_config.defLabelY);
+    hStyle.GetZaxis() -> SetTitleFont(m_config.defHistFont);
+    hStyle.GetZaxis() -> SetTitleSize(m_config.defTitleZ);
+    hStyle.GetZaxis() -> SetTitleOffset(m_config.defOffZ);
+    hStyle.GetZaxis() -> SetLabelSize(m_config.defLabelZ);
+
+    // ...and copy it onto every histogram
+    for (const CutSetOutput& out : m_vecOutputs) {
+      for (TH1* hist : CollectHists(out)) {
+        ApplyStyle(hStyle, hist);
+      }
+    }
+    cout << "    Set histogram styles." << endl;
+
+    // exit internal routine
+    return;
+
+  }  // end 'SetHistogramStyles()'
+
+
+
+  void SReadLambdaJetTree::ApplyStyle(const TH1& style, TH1* hist) const {
+
+    style.TAttLine::Copy(*hist);
+    style.TAttFill::Copy(*hist);
+    style.TAttMarker::Copy(*hist);
+    style.GetXaxis() -> TAttAxis::Copy(*(hist -> GetXaxis()));
+    style.GetYaxis() -> TAttAxis::Copy(*(hist -> GetYaxis()));
+    hist -> GetXaxis() -> CenterTitle(m_config.centerTitle);
+    hist -> GetYaxis() -> CenterTitle(m_config.centerTitle);
+    if (hist -> GetDimension() > 1) {
+      style.GetZaxis() -> TAttAxis::Copy(*(hist -> GetZaxis()));
+      hist -> GetZaxis() -> CenterTitle(m_config.centerTitle);
+    }
+    return;
+
+  }  // end 'ApplyStyle(TH1&, TH1*)'
+
+
+
+  vector<TH1*> SReadLambdaJetTree::CollectHists(const CutSetOutput& out) const {
+
+    vector<TH1*> vecHists(out.vecHistEvt.begin(), out.vecHistEvt.end());
+    for (const auto& type : out.vecHist1D) {
+      for (TH1* h1D : type) {
+        if (h1D) vecHists.push_back(h1D);
+      }
+    }
+    for (const auto& type : out.vecHist2D) {
+      for (const auto& var : type) {
+        for (TH2* h2D : var) {
+          if (h2D) vecHists.push_back(h2D);
+        }
+      }
+    }
+    return vecHists;
+
+  }  // end 'CollectHists(CutSetOutput&)'
+
+
+
+  void SReadLambdaJetTree::SaveOutput() {
+
+    // change output compression if needed
+    if (m_config.outCompression >= 0) {
+      m_outFile -> SetCompressionSettings(m_config.outCompression);
+    }
+
+    for (const CutSetOutput& out : m_vecOutputs) {
+      out.dir -> cd();
+
+      // write histograms either one key each, or all
+      // in one key
+      const vector<TH1*> vecHists = CollectHists(out);
+      if (m_config.saveSingleKey) {
+        TList list;
+        for (TH1* hist : vecHists) {
+          list.Add(hist);
+        }
+        list.Write("Hists", TObject::kSingleKey);
+      } else {
+        for (TH1* hist : vecHists) {
+          hist -> Write();
+        }
+      }
+
+      // write object tuple
+      if (out.tuple) {
+        out.tuple -> Write();
+      }
+
+      // write bootstrap replicas
+      if (m_config.nReplicas > 0) {
+        out.replicas.Write(out.dir, m_hist);
+      }
+
+      // record totals of each type (for merging)
+      for (size_t iType = 0; iType < out.nTot.size(); iType++) {
+        const string name = "nTot" + m_hist.vecTypeNames[iType];
+        TParameter<Long64_t>(name.data(), out.nTot[iType]).Write();
+      }
+    }  // end cut set loop
+
+    // record which entries were processed
+    m_range.Write(m_outDir, m_nEvtsRead);
+    cout << "    Saved histograms." << endl;
+
+    // exit internal routine
+    return;
+
+  }  // end 'SaveOutput()'
 
 
 
   void SReadLambdaJetTree::CloseInput() {
 
-    m_fInput -> cd();
-    m_fInput -> Close();
-    return;
-
-  }  // end 'CloseInput()' 
-
-
-
-  void SReadLambdaJetTree::FillHist1D(const int type, Hist hist) {
-
-    vecHist1D.at(type)[Var::Eta]  -> Fill(hist.eta);
-    vecHist1D.at(type)[Var::Ene]  -> Fill(hist.ene);
-    vecHist1D.at(type)[Var::Pt]   -> Fill(hist.pt);
-    vecHist1D.at(type)[Var::DPhi] -> Fill(hist.df);
-    vecHist1D.at(type)[Var::DEta] -> Fill(hist.dh);
-    vecHist1D.at(type)[Var::Dr]   -> Fill(hist.dr);
-    vecHist1D.at(type)[Var::Z]    -> Fill(hist.z);
-    vecHist1D.at(type)[Var::NL]   -> Fill(hist.nlam);
-    vecHist1D.at(type)[Var::NC]   -> Fill(hist.ncst);
-    vecHist1D.at(type)[Var::RLC]  -> Fill(hist.plam);
-    return;
-
-  }  // end 'FillHist1D(int, Hist)'
-
-
-
-  void SReadLambdaJetTree::FillHist2D(const int type, Hist hist, VsVar vs) {
-
-    // fill vs. eta histograms
-    vecHist2D.at(type)[Var::Eta][Mod::VsEta]  -> Fill(vs.eta, hist.eta);
-    vecHist2D.at(type)[Var::Ene][Mod::VsEta]  -> Fill(vs.eta, hist.ene);
-    vecHist2D.at(type)[Var::Pt][Mod::VsEta]   -> Fill(vs.eta, hist.pt);
-    vecHist2D.at(type)[Var::DPhi][Mod::VsEta] -> Fill(vs.eta, hist.df);
-    vecHist2D.at(type)[Var::DEta][Mod::VsEta] -> Fill(vs.eta, hist.dh);
-    vecHist2D.at(type)[Var::Dr][Mod::VsEta]   -> Fill(vs.eta, hist.dr);
-    vecHist2D.at(type)[Var::Z][Mod::VsEta]    -> Fill(vs.eta, hist.z);
-    vecHist2D.at(type)[Var::NL][Mod::VsEta]   -> Fill(vs.eta, hist.nlam);
-    vecHist2D.at(type)[Var::NC][Mod::VsEta]    -> Fill(vs.eta, hist.ncst);
-    vecHist2D.at(type)[Var::RLC][Mod::VsEta]  -> Fill(vs.eta, hist.plam);
-
-    // fill vs. energy histograms
-    vecHist2D.at(type)[Var::Eta][Mod::VsEne]  -> Fill(vs.ene, hist.eta);
-    vecHist2D.at(type)[Var::Ene][Mod::VsEne]  -> Fill(vs.ene, hist.ene);
-    vecHist2D.at(type)[Var::Pt][Mod::VsEne]   -> Fill(vs.ene, hist.pt);
-    vecHist2D.at(type)[Var::DPhi][Mod::VsEne] -> Fill(vs.ene, hist.df);
-    vecHist2D.at(type)[Var::DEta][Mod::VsEne] -> Fill(vs.ene, hist.dh);
-    vecHist2D.at(type)[Var::Dr][Mod::VsEne]   -> Fill(vs.ene, hist.dr);
-    vecHist2D.at(type)[Var::Z][Mod::VsEne]    -> Fill(vs.ene, hist.z);
-    vecHist2D.at(type)[Var::NL][Mod::VsEne]   -> Fill(vs.ene, hist.nlam);
-    vecHist2D.at(type)[Var::NC][Mod::VsEne]    -> Fill(vs.ene, hist.ncst);
-    vecHist2D.at(type)[Var::RLC][Mod::VsEne]  -> Fill(vs.ene, hist.plam);
-
-    // fill vs. pt histograms
-    vecHist2D.at(type)[Var::Eta][Mod::VsPt]  -> Fill(vs.pt, hist.eta);
-    vecHist2D.at(type)[Var::Ene][Mod::VsPt]  -> Fill(vs.pt, hist.ene);
-    vecHist2D.at(type)[Var::Pt][Mod::VsPt]   -> Fill(vs.pt, hist.pt);
-    vecHist2D.at(type)[Var::DPhi][Mod::VsPt] -> Fill(vs.pt, hist.df);
-    vecHist2D.at(type)[Var::DEta][Mod::VsPt] -> Fill(vs.pt, hist.dh);
-    vecHist2D.at(type)[Var::Dr][Mod::VsPt]   -> Fill(vs.pt, hist.dr);
-    vecHist2D.at(type)[Var::Z][Mod::VsPt]    -> Fill(vs.pt, hist.z);
-    vecHist2D.at(type)[Var::NL][Mod::VsPt]   -> Fill(vs.pt, hist.nlam);
-    vecHist2D.at(type)[Var::NC][Mod::VsPt]    -> Fill(vs.pt, hist.ncst);
-    vecHist2D.at(type)[Var::RLC][Mod::VsPt]  -> Fill(vs.pt, hist.plam);
-
-    // fill vs. delta-phi histograms
-    vecHist2D.at(type)[Var::Eta][Mod::VsDPhi]  -> Fill(vs.df, hist.eta);
-    vecHist2D.at(type)[Var::Ene][Mod::VsDPhi]  -> Fill(vs.df, hist.ene);
-    vecHist2D.at(type)[Var::Pt][Mod::VsDPhi]   -> Fill(vs.df, hist.pt);
-    vecHist2D.at(type)[Var::DPhi][Mod::VsDPhi] -> Fill(vs.df, hist.df);
-    vecHist2D.at(type)[Var::DEta][Mod::VsDPhi] -> Fill(vs.df, hist.dh);
-    vecHist2D.at(type)[Var::Dr][Mod::VsDPhi]   -> Fill(vs.df, hist.dr);
-    vecHist2D.at(type)[Var::Z][Mod::VsDPhi]    -> Fill(vs.df, hist.z);
-    vecHist2D.at(type)[Var::NL][Mod::VsDPhi]   -> Fill(vs.df, hist.nlam);
-    vecHist2D.at(type)[Var::NC][Mod::VsDPhi]    -> Fill(vs.df, hist.ncst);
-    vecHist2D.at(type)[Var::RLC][Mod::VsDPhi]  -> Fill(vs.df, hist.plam);
-
-    // fill vs. delta-eta histograms
-    vecHist2D.at(type)[Var::Eta][Mod::VsDEta]  -> Fill(vs.dh, hist.eta);
-    vecHist2D.at(type)[Var::Ene][Mod::VsDEta]  -> Fill(vs.dh, hist.ene);
-    vecHist2D.at(type)[Var::Pt][Mod::VsDEta]   -> Fill(vs.dh, hist.pt);
-    vecHist2D.at(type)[Var::DPhi][Mod::VsDEta] -> Fill(vs.dh, hist.df);
-    vecHist2D.at(type)[Var::DEta][Mod::VsDEta] -> Fill(vs.dh, hist.dh);
-    vecHist2D.at(type)[Var::Dr][Mod::VsDEta]   -> Fill(vs.dh, hist.dr);
-    vecHist2D.at(type)[Var::Z][Mod::VsDEta]    -> Fill(vs.dh, hist.z);
-    vecHist2D.at(type)[Var::NL][Mod::VsDEta]   -> Fill(vs.dh, hist.nlam);
-    vecHist2D.at(type)[Var::NC][Mod::VsDEta]    -> Fill(vs.dh, hist.ncst);
-    vecHist2D.at(type)[Var::RLC][Mod::VsDEta]  -> Fill(vs.dh, hist.plam);
-    return;
-
-  }  // end 'FillHist2D(int, Hist, VsVar)'
-
-
-
-  bool SReadLambdaJetTree::IsGoodJet(const double pt, const double eta) {
-
-    const bool isGoodPt  = (pt > m_config.ptJetMin);
-    const bool isGoodEta = (abs(eta) < m_config.etaJetMax);
+    // deleting the reader and chain closes any
+    // open file
+    delete m_reader;
+    m_reader = NULL;
+    delete m_tInput;
+    m_tInput = NULL;
+    return;
+
+  }  // end 'CloseInput()'
+
+
+
+  void SReadLambdaJetTree::InitSkim() {
+
+    // open skim file
+    m_fSkim = new TFile(m_config.skimFileName.data(), "recreate");
+    if (!m_fSkim || m_fSkim -> IsZombie()) {
+      cerr << "PANIC: couldn't open skim file:\n"
+           << "       \"" << m_config.skimFileName << "\"\n"
+           << endl;
+      assert(m_fSkim && !m_fSkim -> IsZombie());
+    }
+
+    // clone only active branches, sharing addresses
+    // with the input
+    m_fSkim -> cd();
+    m_tSkim = m_tInput -> CloneTree(0);
+    m_tSkim -> SetDirectory(m_fSkim);
+
+    // and keep track of where each skimmed event came from
+    TDirectory* dManifest = m_fSkim -> mkdir("SkimManifest");
+    dManifest -> cd();
+    m_tSkimEntries = new TTree("SkimEntries", "Source entry of each skimmed event");
+    m_tSkimEntries -> Branch("SrcEntry", &m_skimSrcEntry, "SrcEntry/L");
+    m_tSkimEntries -> SetDirectory(dManifest);
+
+    // go back to main output
+    m_outDir -> cd();
+    cout << "    Initialized skim output: \"" << m_config.skimFileName << "\"." << endl;
+    return;
+
+  }  // end 'InitSkim()'
+
+
+
+  void SReadLambdaJetTree::SkimEvent(const int64_t iEvt) {
+
+    const size_t nVecJets = m_jetPt    -> size();
+    const size_t nVecLams = m_lambdaPt -> size();
+
+    // flag lambdas and jets passing cuts of any cut set
+    bool hasGoodLam = false;
+    m_vecKeepLam.assign(nVecLams, false);
+    m_vecKeepJet.assign(nVecJets, false);
+    for (const CutSetOutput& out : m_vecOutputs) {
+      for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+        if (IsGoodLambda(out.cuts, m_lambdaPt -> at(iLam), m_lambdaEta -> at(iLam))) {
+          m_vecKeepLam[iLam] = true;
+          hasGoodLam         = true;
+        }
+      }
+      for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+        if (IsGoodJet(out.cuts, m_jetPt -> at(iJet), m_jetEta -> at(iJet))) {
+          m_vecKeepJet[iJet] = true;
+        }
+      }
+    }
+    if (!hasGoodLam) return;
+
+    // drop failing objects: input vectors are refilled
+    // on the next entry, so they can be trimmed in place
+    if (m_config.skimObjects) {
+      KeepSelected(m_lambdaID,      m_vecKeepLam);
+      KeepSelected(m_lambdaPID,     m_vecKeepLam);
+      KeepSelected(m_lambdaJetID,   m_vecKeepLam);
+      KeepSelected(m_lambdaEmbedID, m_vecKeepLam);
+      KeepSelected(m_lambdaZ,       m_vecKeepLam);
+      KeepSelected(m_lambdaDr,      m_vecKeepLam);
+      KeepSelected(m_lambdaEnergy,  m_vecKeepLam);
+      KeepSelected(m_lambdaPt,      m_vecKeepLam);
+      KeepSelected(m_lambdaEta,     m_vecKeepLam);
+      KeepSelected(m_lambdaPhi,     m_vecKeepLam);
+      KeepSelected(m_jetHasLambda,  m_vecKeepJet);
+      KeepSelected(m_jetNCst,       m_vecKeepJet);
+      KeepSelected(m_jetID,         m_vecKeepJet);
+      KeepSelected(m_jetE,          m_vecKeepJet);
+      KeepSelected(m_jetPt,         m_vecKeepJet);
+      KeepSelected(m_jetEta,        m_vecKeepJet);
+      KeepSelected(m_jetPhi,        m_vecKeepJet);
+      KeepSelected(m_cstID,         m_vecKeepJet);
+      KeepSelected(m_cstPID,        m_vecKeepJet);
+      KeepSelected(m_cstJetID,      m_vecKeepJet);
+      KeepSelected(m_cstEmbedID,    m_vecKeepJet);
+      KeepSelected(m_cstZ,          m_vecKeepJet);
+      KeepSelected(m_cstDr,         m_vecKeepJet);
+      KeepSelected(m_cstEnergy,     m_vecKeepJet);
+      KeepSelected(m_cstPt,         m_vecKeepJet);
+      KeepSelected(m_cstEta,        m_vecKeepJet);
+      KeepSelected(m_cstPhi,        m_vecKeepJet);
+    }
+
+    // write event and its source entry
+    m_skimSrcEntry = iEvt;
+    m_tSkim        -> Fill();
+    m_tSkimEntries -> Fill();
+    return;
+
+  }  // end 'SkimEvent(int64_t)'
+
+
+
+  void SReadLambdaJetTree::SaveSkim() {
+
+    // write skimmed tree
+    m_fSkim -> cd();
+    m_tSkim -> Write();
+
+    // record cuts, input and entries in manifest
+    TDirectory* dManifest = m_fSkim -> GetDirectory("SkimManifest");
+    dManifest -> cd();
+    m_tSkimEntries -> Write();
+    for (const CutSetOutput& out : m_vecOutputs) {
+      const string prefix = out.cuts.name.empty() ? "" : out.cuts.name + "_";
+      TParameter<double>((prefix + "ptJetMin").data(),  out.cuts.ptJetMin).Write();
+      TParameter<double>((prefix + "ptLamMin").data(),  out.cuts.ptLamMin).Write();
+      TParameter<double>((prefix + "etaJetMax").data(), out.cuts.etaJetMax).Write();
+      TParameter<double>((prefix + "etaLamMax").data(), out.cuts.etaLamMax).Write();
+      TParameter<double>((prefix + "zLeadMin").data(),  out.cuts.zLeadMin).Write();
+    }
+    TParameter<bool>("skimObjects", m_config.skimObjects).Write();
+    TNamed("inTreeName", m_config.inTreeName.data()).Write();
+    for (int32_t iFile = 0; iFile < m_tInput -> GetListOfFiles() -> GetEntries(); iFile++) {
+      const string name = "inFile" + to_string(iFile);
+      TNamed(name.data(), m_tInput -> GetListOfFiles() -> At(iFile) -> GetTitle()).Write();
+    }
+    m_range.Write(dManifest, m_nEvtsRead);
+    TParameter<Long64_t>("nEntriesSkimmed", m_tSkimEntries -> GetEntries()).Write();
+    cout << "    Saved skim: " << m_tSkimEntries -> GetEntries() << " of " << m_nEvtsRead << " events kept." << endl;
+
+    // close skim file (this deletes the trees)
+    m_fSkim -> Close();
+    delete m_fSkim;
+    m_fSkim        = NULL;
+    m_tSkim        = NULL;
+    m_tSkimEntries = NULL;
+    return;
+
+  }  // end 'SaveSkim()'
+
+
+
+  bool SReadLambdaJetTree::IsCheckpointOn() const {
+
+    const bool isOn = (
+      !m_config.checkpointFile.empty() &&
+      ((m_config.checkpointEvents > 0) || (m_config.checkpointSeconds > 0.))
+    );
+    return isOn;
+
+  }  // end 'IsCheckpointOn()'
+
+
+
+  uint64_t SReadLambdaJetTree::GetNHistCopies() const {
+
+    // checkpoints keep a snapshot next to the booked
+    // histograms, and threaded runs book one set per
+    // worker on top of the set they're merged into
+    // (n.b. checkpoints force a single event loop)
+    const bool isSingleLoop = (m_config.doSkim || m_config.doTuple || m_config.resume || IsCheckpointOn());
+    if (IsCheckpointOn()) {
+      return 2;
+    } else if (!isSingleLoop && (m_config.nThreads > 1)) {
+      return (uint64_t) m_config.nThreads + 1;
+    } else {
+      return 1;
+    }
+
+  }  // end 'GetNHistCopies()'
+
+
+
+  void SReadLambdaJetTree::WriteCheckpoint(const int64_t nextEntry, const int64_t nRead, const int64_t nBytes) {
+
+    // copy state into the writer's snapshot: only the
+    // snapshot is touched by the writing thread, and
+    // after the first checkpoint its buffers are reused
+    // (sparse histograms are still cloned since their
+    // size changes as bins are filled)
+    SCheckpointState* state = &(m_checkpoint -> GetState());
+    state -> Begin();
+    state -> firstEntry = m_range.first;
+    state -> lastEntry  = m_range.last;
+    state -> nextEntry  = nextEntry;
+    state -> nEvtsRead  = nRead;
+    state -> nBytesRead = nBytes;
+    state -> fingerprint = GetFingerprint();
+
+    for (size_t iSet = 0; iSet < m_vecOutputs.size(); iSet++) {
+
+      const CutSetOutput& out = m_vecOutputs[iSet];
+      const string        dir = "set" + to_string(iSet);
+
+      // event histograms and counters
+      for (auto hEvt : out.vecHistEvt) {
+        state -> AddHist(dir, hEvt);
+      }
+      state -> AddArray(dir, "nTot", out.nTot);
+
+      // jet/lambda histograms
+      if (m_config.useFillTable) {
+        state -> AddArray(dir, "tableCounts1D", out.table.vecCounts1D);
+        state -> AddArray(dir, "tableCounts2D", out.table.vecCounts2D);
+        state -> AddArray(dir, "tableStats1D",  out.table.vecStats1D);
+        state -> AddArray(dir, "tableStats2D",  out.table.vecStats2D);
+        state -> AddArray(dir, "tableEntries",  out.table.vecEntries);
+      }
+      for (auto type : out.vecHist1D) {
+        for (auto h1D : type) {
+          if (h1D) state -> AddHist(dir, h1D);
+        }
+      }
+      for (auto type : out.vecHist2D) {
+        for (auto var : type) {
+          for (auto h2D : var) {
+            if (h2D) state -> AddHist(dir, h2D);
+          }
+        }
+      }
+      for (auto type : out.vecSparse) {
+        for (auto sparse : type) {
+          if (sparse) state -> AddObject(dir, sparse -> Clone());
+        }
+      }
+
+      // bootstrap replicas
+      if (m_config.nReplicas > 0) {
+        state -> AddArray(dir, "replicaCounts", out.replicas.vecCounts);
+        state -> AddArray(dir, "replicaTot",    out.replicas.vecTot);
+      }
+    }  // end cut set loop
+
+    // then hand off to writer
+    m_checkpoint -> Start(m_config.checkpointFile);
+    if (m_isDebugOn) {
+      cout << "    Started checkpoint at entry " << nextEntry << "." << endl;
+    }
+    return;
+
+  }  // end 'WriteCheckpoint(int64_t, int64_t, int64_t)'
+
+
+
+  void SReadLambdaJetTree::ReadCheckpoint() {
+
+    // nothing to do if there's no checkpoint yet
+    TFile* file = TFile::Open(m_config.checkpointFile.data(), "read");
+    if (!file || file -> IsZombie()) {
+      cout << "    No checkpoint found at \"" << m_config.checkpointFile << "\": starting from the beginning." << endl;
+      delete file;
+      return;
+    }
+
+    auto readPar = [file](const string name) {
+      TParameter<Long64_t>* par = NULL;
+      file -> GetObject(name.data(), par);
+      return par ? (int64_t) par -> GetVal() : (int64_t) -1;
+    };
+
+    // make sure checkpoint is for the same range
+    const int64_t firstEntry = readPar("firstEntry");
+    const int64_t lastEntry  = readPar("lastEntry");
+    if ((firstEntry != m_range.first) || (lastEntry != m_range.last)) {
+      cerr << "PANIC: checkpoint is for entries [" << firstEntry << ", " << lastEntry << ") "
+           << "but this run is for [" << m_range.first << ", " << m_range.last << ")!\n"
+           << endl;
+      assert((firstEntry == m_range.first) && (lastEntry == m_range.last));
+    }
+
+    // and that it's somewhere inside that range
+    const int64_t nextEntry = readPar("nextEntry");
+    const bool    isInRange = (nextEntry >= m_range.first) && (nextEntry <= m_range.last);
+    if (!isInRange || (readPar("nEvtsRead") < 0) || (readPar("nBytesRead") < 0)) {
+      cerr << "PANIC: checkpoint has no valid entry to resume from (next entry = " << nextEntry << ")!\n" << endl;
+      assert(isInRange && (readPar("nEvtsRead") >= 0) && (readPar("nBytesRead") >= 0));
+    }
+
+    // and for the same cuts and histograms
+    TNamed* print = NULL;
+    file -> GetObject("fingerprint", print);
+    const bool isSame = print && (GetFingerprint() == print -> GetTitle());
+    if (!isSame) {
+      cerr << "PANIC: checkpoint was written with different cuts or histograms!\n"
+           << "       checkpoint: " << (print ? print -> GetTitle() : "(none)") << "\n"
+           << "       this run:   " << GetFingerprint() << "\n"
+           << endl;
+      assert(isSame);
+    }
+    delete print;
+
+    // restore state of each cut set
+    auto restoreArray = [](TDirectory* dir, const string name, vector<double>& array) {
+      const bool isRead = SCheckpointState::ReadArray(dir, name, array);
+      if (!isRead) {
+        cerr << "PANIC: couldn't restore \"" << name << "\" from checkpoint: has the configuration changed?\n" << endl;
+        assert(isRead);
+      }
+    };
+
+    auto restoreHist = [](TDirectory* dir, TH1* hist) {
+      TH1* saved = NULL;
+      dir -> GetObject(hist -> GetName(), saved);
+      if (!saved) {
+        cerr << "PANIC: couldn't restore \"" << hist -> GetName() << "\" from checkpoint: has the configuration changed?\n" << endl;
+        assert(saved);
+      }
+      hist -> Add(saved);
+      delete saved;
+    };
+
+    for (size_t iSet = 0; iSet < m_vecOutputs.size(); iSet++) {
+
+      CutSetOutput& out = m_vecOutputs[iSet];
+      TDirectory*   dir = file -> GetDirectory(("set" + to_string(iSet)).data());
+      if (!dir) {
+        cerr << "PANIC: checkpoint has no state for cut set " << iSet << "!\n" << endl;
+        assert(dir);
+      }
+
+      // event histograms and counters
+      for (auto hEvt : out.vecHistEvt) {
+        restoreHist(dir, hEvt);
+      }
+      vector<double> nTot(out.nTot.size(), 0.);
+      restoreArray(dir, "nTot", nTot);
+      out.nTot.assign(nTot.begin(), nTot.end());
+
+      // jet/lambda histograms
+      if (m_config.useFillTable) {
+        vector<double> entries(out.table.vecEntries.size(), 0.);
+        restoreArray(dir, "tableCounts1D", out.table.vecCounts1D);
+        restoreArray(dir, "tableCounts2D", out.table.vecCounts2D);
+        restoreArray(dir, "tableStats1D",  out.table.vecStats1D);
+        restoreArray(dir, "tableStats2D",  out.table.vecStats2D);
+        restoreArray(dir, "tableEntries",  entries);
+        out.table.vecEntries.assign(entries.begin(), entries.end());
+      }
+      for (auto type : out.vecHist1D) {
+        for (auto h1D : type) {
+          if (h1D) restoreHist(dir, h1D);
+        }
+      }
+      for (auto type : out.vecHist2D) {
+        for (auto var : type) {
+          for (auto h2D : var) {
+            if (h2D) restoreHist(dir, h2D);
+          }
+        }
+      }
+      for (auto type : out.vecSparse) {
+        for (auto sparse : type) {
+          if (!sparse) continue;
+          THnSparseD* saved = NULL;
+          dir -> GetObject(sparse -> GetName(), saved);
+          if (!saved) {
+            cerr << "PANIC: couldn't restore \"" << sparse -> GetName() << "\" from checkpoint: has the configuration changed?\n" << endl;
+            assert(saved);
+          }
+          sparse -> Add(saved);
+          delete saved;
+        }
+      }
+
+      // bootstrap replicas
+      if (m_config.nReplicas > 0) {
+        restoreArray(dir, "replicaCounts", out.replicas.vecCounts);
+        restoreArray(dir, "replicaTot",    out.replicas.vecTot);
+      }
+    }  // end cut set loop
+
+    // and pick up where the checkpoint left off
+    m_firstEntry = nextEntry;
+    m_nEvtsRead  = readPar("nEvtsRead");
+    m_nBytesRead = readPar("nBytesRead");
+    cout << "    Resuming from checkpoint at entry " << m_firstEntry << " (" << m_nEvtsRead << " entries already read)." << endl;
+    if (m_config.doSkim || m_config.doTuple) {
+      cout << "    WARNING: skim and tuple outputs only hold entries after " << m_firstEntry << "." << endl;
+    }
+
+    file -> Close();
+    delete file;
+    m_outDir -> cd();
+    return;
+
+  }  // end 'ReadCheckpoint()'
+
+
+
+  string SReadLambdaJetTree::GetFingerprint() const {
+
+    // cuts of each set
+    string print = "cuts:";
+    for (const CutSetOutput& out : m_vecOutputs) {
+      print += " " + out.cuts.name + "(" +
+        to_string(out.cuts.ptJetMin)  + "," +
+        to_string(out.cuts.ptLamMin)  + "," +
+        to_string(out.cuts.etaJetMax) + "," +
+        to_string(out.cuts.etaLamMax) + "," +
+        to_string(out.cuts.zLeadMin)  + ")";
+    }
+
+    // histograms and their binning
+    print += "; types:";
+    for (const string& type : m_hist.vecTypeNames) {
+      print += " " + type;
+    }
+    print += "; vars:";
+    for (size_t iVar = 0; iVar < m_hist.vecBaseNames.size(); iVar++) {
+      print += " " + m_hist.vecBaseNames[iVar] + "(" +
+        to_string(get<1>(m_hist.vecAxisDef[iVar]))        + "," +
+        to_string(get<2>(m_hist.vecAxisDef[iVar]).first)  + "," +
+        to_string(get<2>(m_hist.vecAxisDef[iVar]).second) + ")";
+    }
+    print += "; vs:";
+    for (size_t iVs = 0; iVs < m_hist.vecVsMods.size(); iVs++) {
+      print += " " + m_hist.vecVsMods[iVs] + "(" +
+        to_string(get<1>(m_hist.vecVsDef[iVs]))        + "," +
+        to_string(get<2>(m_hist.vecVsDef[iVs]).first)  + "," +
+        to_string(get<2>(m_hist.vecVsDef[iVs]).second) + ")";
+    }
+    print += "; book:";
+    for (const auto& [type, var, vs] : m_hist.vecToBook) {
+      print += " " + type + "/" + var + "/" + vs;
+    }
+
+    // and how they're stored
+    print += "; table=" + to_string(m_config.useFillTable);
+    print += "; sparse=" + to_string(m_config.useSparse);
+    print += "; replicas=" + to_string(m_config.nReplicas) + "/" + to_string(m_config.replicaSeed);
+    for (const auto& [type, var] : m_hist.vecToReplicate) {
+      print += " " + type + "/" + var;
+    }
+    return print;
+
+  }  // end 'GetFingerprint()'
+
+
+
+  void SReadLambdaJetTree::BuildAssocIndex() {
+
+    const size_t nVecJets = m_jetPt    -> size();
+    const size_t nVecLams = m_lambdaPt -> size();
+
+    // map jet ids onto jet indices
+    m_mapJetIDOntoIndex.clear();
+    for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+      m_mapJetIDOntoIndex.emplace((int) (*m_jetID)[iJet], iJet);
+    }
+
+    // find jet of each lambda and count lambdas per jet
+    m_vecAssocStart.assign(nVecJets + 1, 0);
+    m_vecJetMaxLamZ.assign(nVecJets, -1.);
+    m_vecLamJetIndex.assign(nVecLams, -1);
+    for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+
+      auto itJet = m_mapJetIDOntoIndex.find((*m_lambdaJetID)[iLam]);
+      if (itJet == m_mapJetIDOntoIndex.end()) continue;
+
+      // double-check association
+      const size_t iJet       = itJet -> second;
+      const bool   isAssocLam = IsAssociatedLambda((*m_lambdaJetID)[iLam], (*m_jetID)[iJet]);
+      if (!isAssocLam) continue;
+
+      m_vecLamJetIndex[iLam] = iJet;
+      ++m_vecAssocStart[iJet + 1];
+
+      // keep highest lambda z in each jet so that the
+      // leading lambda cut can be applied per cut set
+      m_vecJetMaxLamZ[iJet] = max(m_vecJetMaxLamZ[iJet], (*m_lambdaZ)[iLam]);
+    }  // end lambda loop
+
+    // turn counts into offsets
+    for (size_t iJet = 0; iJet < nVecJets; iJet++) {
+      m_vecAssocStart[iJet + 1] += m_vecAssocStart[iJet];
+    }
+
+    // and fill lambda indices, keeping the original lambda order
+    m_vecAssocCursor.assign(m_vecAssocStart.begin(), m_vecAssocStart.end() - 1);
+    m_vecAssocLam.resize(m_vecAssocStart.back());
+    for (size_t iLam = 0; iLam < nVecLams; iLam++) {
+      if (m_vecLamJetIndex[iLam] < 0) continue;
+      m_vecAssocLam[m_vecAssocCursor[m_vecLamJetIndex[iLam]]++] = iLam;
+    }
+    return;
+
+  }  // end 'BuildAssocIndex()'
+
+
+
+  void SReadLambdaJetTree::LoadEvent() {
+
+    // point the event view at this entry's input
+    m_event.Load(
+      *m_jetEta,
+      *m_jetE,
+      *m_jetPt,
+      *m_jetPhi,
+      *m_jetNCst,
+      m_vecAssocStart,
+      *m_lambdaEta,
+      *m_lambdaEnergy,
+      *m_lambdaPt,
+      *m_lambdaPhi,
+      *m_lambdaDr,
+      *m_lambdaZ
+    );
+    return;
+
+  }  // end 'LoadEvent()'
+
+
+
+  void SReadLambdaJetTree::InitTuple(CutSetOutput& out) {
+
+    // tuple lives in cut set's directory
+    out.dir -> cd();
+    out.tuple = new TTree("ObjTuple", "Selected lambdas and jets");
+    out.tuple -> Branch("evt",   &m_row.evt,   "evt/L");
+    out.tuple -> Branch("flags", &m_row.flags, "flags/s");
+    out.tuple -> Branch("isLam", &m_row.isLam, "isLam/O");
+    out.tuple -> Branch("eta",   &m_row.eta,   "eta/F");
+    out.tuple -> Branch("ene",   &m_row.ene,   "ene/F");
+    out.tuple -> Branch("pt",    &m_row.pt,    "pt/F");
+    out.tuple -> Branch("df",    &m_row.df,    "df/F");
+    out.tuple -> Branch("dh",    &m_row.dh,    "dh/F");
+    out.tuple -> Branch("dr",    &m_row.dr,    "dr/F");
+    out.tuple -> Branch("z",     &m_row.z,     "z/F");
+    out.tuple -> Branch("nlam",  &m_row.nlam,  "nlam/F");
+    out.tuple -> Branch("ncst",  &m_row.ncst,  "ncst/F");
+    out.tuple -> Branch("plam",  &m_row.plam,  "plam/F");
+    out.tuple -> SetDirectory(out.dir);
+    return;
+
+  }  // end 'InitTuple(CutSetOutput&)'
+
+
+
+  void SReadLambdaJetTree::TagForTuple(
+    vector<UShort_t>& flags,
+    vector<Hist>& rows,
+    const size_t index,
+    const int type,
+    const Hist& hist
+  ) {
+
+    // values are the same for every type an object
+    // is filled into
+    flags[index] |= (1 << type);
+    rows[index]   = hist;
+    return;
+
+  }  // end 'TagForTuple(vector<UShort_t>&, vector<Hist>&, size_t, int, Hist&)'
+
+
+
+  void SReadLambdaJetTree::FillTuple(CutSetOutput& out) {
+
+    // lambdas first, then jets
+    for (const bool isLam : {true, false}) {
+      const vector<UShort_t>& flags = isLam ? m_vecLamFlags : m_vecJetFlags;
+      const vector<Hist>&     rows  = isLam ? m_vecLamRows  : m_vecJetRows;
+      for (size_t iObj = 0; iObj < flags.size(); iObj++) {
+        if (flags[iObj] == 0) continue;
+        m_row.flags = flags[iObj];
+        m_row.isLam = isLam;
+        m_row.eta   = rows[iObj].eta;
+        m_row.ene   = rows[iObj].ene;
+        m_row.pt    = rows[iObj].pt;
+        m_row.df    = rows[iObj].df;
+        m_row.dh    = rows[iObj].dh;
+        m_row.dr    = rows[iObj].dr;
+        m_row.z     = rows[iObj].z;
+        m_row.nlam  = rows[iObj].nlam;
+        m_row.ncst  = rows[iObj].ncst;
+        m_row.plam  = rows[iObj].plam;
+        out.tuple -> Fill();
+      }
+    }
+    return;
+
+  }  // end 'FillTuple(CutSetOutput&)'
+
+
+
+  void SReadLambdaJetTree::FillHists(CutSetOutput& out, const int type, Hist hist, VsVar vs) {
+
+    // collect values in same order as histogram definitions
+    const double vals[]   = {hist.eta, hist.ene, hist.pt, hist.df, hist.dh, hist.dr, hist.z, hist.nlam, hist.ncst, hist.plam};
+    const double vsVals[] = {vs.eta, vs.ene, vs.pt, vs.df, vs.dh};
+
+    // if using sparse histograms, fill each family
+    // once; if using fill table, find each bin once
+    // and increment counts
+    if (m_config.useSparse) {
+      double point[] = {0., vs.eta, vs.ene, vs.pt, vs.df, vs.dh};
+      for (size_t iVar = 0; iVar < out.vecSparse.at(type).size(); iVar++) {
+        THnSparseD* sparse = out.vecSparse[type][iVar];
+        if (!sparse) continue;
+        point[0] = vals[iVar];
+        sparse -> Fill(point);
+      }
+    } else if (m_config.useFillTable) {
+      out.table.Fill(type, vals, vsVals);
+    } else {
+      FillHist1D(out, type, vals);
+      FillHist2D(out, type, vals, vsVals);
+    }
+
+    // and fill bootstrap replicas with this event's weights
+    if (m_config.nReplicas > 0) {
+      out.replicas.Fill(type, vals, m_bootWeights.weights);
+    }
+    return;
+
+  }  // end 'FillHists(CutSetOutput&, int, Hist, VsVar)'
+
+
+
+  void SReadLambdaJetTree::FillHist1D(CutSetOutput& out, const int type, const double* vals) {
+
+    for (size_t iVar = 0; iVar < out.vecHist1D.at(type).size(); iVar++) {
+      TH1* h1D = out.vecHist1D[type][iVar];
+      if (h1D) h1D -> Fill(vals[iVar]);
+    }
+    return;
+
+  }  // end 'FillHist1D(CutSetOutput&, int, double*)'
+
+
+
+  void SReadLambdaJetTree::FillHist2D(CutSetOutput& out, const int type, const double* vals, const double* vsVals) {
+
+    for (size_t iVar = 0; iVar < out.vecHist2D.at(type).size(); iVar++) {
+      for (size_t iVs = 0; iVs < out.vecHist2D[type][iVar].size(); iVs++) {
+        TH2* h2D = out.vecHist2D[type][iVar][iVs];
+        if (h2D) h2D -> Fill(vsVals[iVs], vals[iVar]);
+      }
+    }
+    return;
+
+  }  // end 'FillHist2D(CutSetOutput&, int, double*, double*)'
+
+
+
+  bool SReadLambdaJetTree::IsGoodJet(const SReadLambdaJetTreeCuts& cuts, const double pt, const double eta) const {
+
+    const bool isGoodPt  = (pt > cuts.ptJetMin);
+    const bool isGoodEta = (abs(eta) < cuts.etaJetMax);
     const bool isGoodJet = (isGoodPt && isGoodEta);
     return isGoodJet;
 
-  }  // end 'IsGoodJet(double, double)'
+  }  // end 'IsGoodJet(SReadLambdaJetTreeCuts&, double, double)'
 
 
 
-  bool SReadLambdaJetTree::IsGoodLambda(const double pt, const double eta) {
+  bool SReadLambdaJetTree::IsGoodLambda(const SReadLambdaJetTreeCuts& cuts, const double pt, const double eta) const {
 
-    const bool isGoodPt  = (pt > m_config.ptLamMin);
-    const bool isGoodEta = (abs(eta) < m_config.etaLamMax);
+    const bool isGoodPt  = (pt > cuts.ptLamMin);
+    const bool isGoodEta = (abs(eta) < cuts.etaLamMax);
     const bool isGoodLam = (isGoodPt && isGoodEta);
     return isGoodLam;
 
-  }  // end 'IsGoodLambda(double, double)'
+  }  // end 'IsGoodLambda(SReadLambdaJetTreeCuts&, double, double)'
 
 
 
-  bool SReadLambdaJetTree::IsLeadingLambda(const double z) {
+  bool SReadLambdaJetTree::IsLeadingLambda(const SReadLambdaJetTreeCuts& cuts, const double z) const {
 
-    const bool isLeadLam = (z > m_config.zLeadMin);
+    const bool isLeadLam = (z > cuts.zLeadMin);
     return isLeadLam;
 
-  }  // end 'IsLeadingLambda(double)'
+  }  // end 'IsLeadingLambda(SReadLambdaJetTreeCuts&, double)'
 
 
 
-  bool SReadLambdaJetTree::IsAssociatedLambda(const int idLam, const int idJet) {
+  bool SReadLambdaJetTree::IsAssociatedLambda(const int idLam, const int idJet) const {
 
     const bool isAssoc = (idLam == idJet);
     return isAssoc;
@@ -757,7 +2474,7 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
-  double SReadLambdaJetTree::GetDeltaPhi(const double phiA, const double phiB) {
+  double SReadLambdaJetTree::GetDeltaPhi(const double phiA, const double phiB) const {
 
     double dPhi = phiA - phiB;
     if (dPhi < m_const.minDPhi) dPhi += TMath::TwoPi();
@@ -768,7 +2485,7 @@ namespace SColdQcdCorrelatorAnalysis {
 
 
 
-  double SReadLambdaJetTree::GetDeltaEta(const double etaA, const double etaB) {
+  double SReadLambdaJetTree::GetDeltaEta(const double etaA, const double etaB) const {
 
     const double dEta = etaA - etaB;
     return dEta;
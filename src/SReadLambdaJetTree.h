@@ -13,22 +13,43 @@
 
 // c++ utilities
 #include <cmath>
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <cassert>
+#include <thread>
 #include <utility>
+#include <unordered_map>
+#include <fstream>
 #include <iostream>
 // root libraries
 #include <TH1.h>
 #include <TH2.h>
 #include <TMath.h>
 #include <TFile.h>
+#include <TROOT.h>
+#include <TList.h>
 #include <TTree.h>
+#include <TChain.h>
+#include <TNamed.h>
 #include <TCanvas.h>
+#include <TParameter.h>
+#include <THnSparse.h>
+#include <ROOT/RVec.hxx>
+#include <ROOT/RDataFrame.hxx>
 // plugin definitions
 #include "SBaseQAPlugin.h"
+#include "SCheckpoint.h"
+#include "SEntryRange.h"
+#include "SHistPolicy.h"
+#include "SInputReader.h"
+#include "SProgressMeter.h"
 #include "SReadLambdaJetTreeConfig.h"
+#include "SReadLambdaJetTreeEvent.h"
+#include "SReadLambdaJetTreeBootstrap.h"
 #include "SReadLambdaJetTreeHistDef.h"
+#include "SReadLambdaJetTreeFillTable.h"
 
 // make common namespaces implicit
 using namespace std;
@@ -97,35 +118,210 @@ namespace SColdQcdCorrelatorAnalysis {
 
     private:
 
+      // histograms and counters for one set of cuts
+      struct CutSetOutput {
+        SReadLambdaJetTreeCuts        cuts;
+        TDirectory*                   dir = NULL;
+        vector<TH1D*>                 vecHistEvt;
+        vector<vector<TH1*>>          vecHist1D;
+        vector<vector<vector<TH2*>>>  vecHist2D;
+        vector<vector<THnSparseD*>>   vecSparse;
+        SReadLambdaJetTreeFillTable   table;
+        vector<uint64_t>              nTot;
+        SReadLambdaJetTreeReplicas    replicas;
+        TTree*                        tuple = NULL;
+      };
+
+      // counts shared by worker threads so the main
+      // thread can report progress while they run
+      // (workers add to them every NBatch entries)
+      struct SharedProgress {
+        static const int64_t NBatch = 256;
+        atomic<int64_t>      nEvts     {0};
+        atomic<int64_t>      nBytes    {0};
+        atomic<size_t>       nFinished {0};
+      };
+
+      // row of object tuple: flags has bit (1 << type)
+      // set for each histogram type the object was
+      // filled into
+      struct TupleRow {
+        Long64_t evt   = 0;
+        UShort_t flags = 0;
+        Bool_t   isLam = false;
+        Float_t  eta   = 0.;
+        Float_t  ene   = 0.;
+        Float_t  pt    = 0.;
+        Float_t  df    = 0.;
+        Float_t  dh    = 0.;
+        Float_t  dr    = 0.;
+        Float_t  z     = 0.;
+        Float_t  nlam  = 0.;
+        Float_t  ncst  = 0.;
+        Float_t  plam  = 0.;
+      };
+
+      // objects selected in one event for one cut set
+      // (used by the rdataframe backend)
+      struct EventRows {
+        vector<vector<Hist>> vecRows;
+        vector<double>       vecNLamJet;
+        vector<uint64_t>     nEvt;
+      };
+
       // internal methods
       void   InitInput();
+      void   InitRange();
+      void   AddInputFiles(const string input);
       void   InitTree();
       void   InitHists();
+      void   InitHistPolicy();
+      void   ReportMemory();
+      void   BookHists(CutSetOutput& out);
+      void   MaterializeHists();
+      void   BookSparse(CutSetOutput& out);
+      void   ProjectSparse();
       void   DoAnalysis();
+      void   ProcessEvent(CutSetOutput& out);
+      void   DoParallelAnalysis();
+      void   DoRDataFrameAnalysis();
+      void   MergeWorkers();
+      void   PrintSummary(const CutSetOutput& out);
       void   SetHistogramStyles();
+      void   ApplyStyle(const TH1& style, TH1* hist) const;
       void   SaveOutput();
+      vector<TH1*> CollectHists(const CutSetOutput& out) const;
       void   CloseInput();
-      void   FillHist1D(const int type, Hist hist);
-      void   FillHist2D(const int type, Hist hist, VsVar vs);
-      bool   IsGoodJet(const double pt, const double eta);
-      bool   IsGoodLambda(const double pt, const double eta);
-      bool   IsLeadingLambda(const double z);
-      bool   IsAssociatedLambda(const int idLam, const int idJet);
-      double GetDeltaPhi(const double phiA, const double phiB);
-      double GetDeltaEta(const double etaA, const double etaB);
-
-      // inputs
-      TFile* m_fInput = NULL;
-      TTree* m_tInput = NULL;
-
-      // histograms
-      vector<TH1D*>                 vecHistEvt;
-      vector<vector<TH1D*>>         vecHist1D;
-      vector<vector<vector<TH2D*>>> vecHist2D;
+      void   InitSkim();
+      void   SkimEvent(const int64_t iEvt);
+      void   SaveSkim();
+      bool   IsCheckpointOn() const;
+      uint64_t GetNHistCopies() const;
+      void   WriteCheckpoint(const int64_t nextEntry, const int64_t nRead, const int64_t nBytes);
+      void   ReadCheckpoint();
+      string GetFingerprint() const;
+      void   BuildAssocIndex();
+      void   LoadEvent();
+      void   InitTuple(CutSetOutput& out);
+      void   TagForTuple(vector<UShort_t>& flags, vector<Hist>& rows, const size_t index, const int type, const Hist& hist);
+      void   FillTuple(CutSetOutput& out);
+      void   FillHists(CutSetOutput& out, const int type, Hist hist, VsVar vs);
+      void   FillHist1D(CutSetOutput& out, const int type, const double* vals);
+      void   FillHist2D(CutSetOutput& out, const int type, const double* vals, const double* vsVals);
+      bool   IsGoodJet(const SReadLambdaJetTreeCuts& cuts, const double pt, const double eta) const;
+      bool   IsGoodLambda(const SReadLambdaJetTreeCuts& cuts, const double pt, const double eta) const;
+      bool   IsLeadingLambda(const SReadLambdaJetTreeCuts& cuts, const double z) const;
+      bool   IsAssociatedLambda(const int idLam, const int idJet) const;
+      double GetDeltaPhi(const double phiA, const double phiB) const;
+      double GetDeltaEta(const double etaA, const double etaB) const;
+
+      // rdataframe selection: same as ProcessEvent, but
+      // collects values rather than filling
+      vector<EventRows> SelectEvent(
+        const ROOT::RVec<uint64_t>& jetNCst,
+        const ROOT::RVec<uint64_t>& jetID,
+        const ROOT::RVec<double>&   jetE,
+        const ROOT::RVec<double>&   jetPt,
+        const ROOT::RVec<double>&   jetEta,
+        const ROOT::RVec<double>&   jetPhi,
+        const ROOT::RVec<int>&      lamJetID,
+        const ROOT::RVec<double>&   lamZ,
+        const ROOT::RVec<double>&   lamDr,
+        const ROOT::RVec<double>&   lamE,
+        const ROOT::RVec<double>&   lamPt,
+        const ROOT::RVec<double>&   lamEta,
+        const ROOT::RVec<double>&   lamPhi
+      ) const;
+
+      // keep only selected elements of a per-object input
+      // vector (unread branches are left alone)
+      template <typename T> void KeepSelected(vector<T>* vec, const vector<bool>& keep) {
+        if (!vec || (vec -> size() != keep.size())) return;
+        size_t nKept = 0;
+        for (size_t iObj = 0; iObj < keep.size(); iObj++) {
+          if (keep[iObj]) (*vec)[nKept++] = (*vec)[iObj];
+        }
+        vec -> resize(nKept);
+        return;
+      }  // end 'KeepSelected(vector<T>*, vector<bool>&)'
+
+      // input chain (lists the input files) and reader
+      // of tree or rntuple entries
+      TChain*       m_tInput = NULL;
+      SInputReader* m_reader = NULL;
+
+      // outputs for each set of cuts (1st is the
+      // cuts in the main configuration)
+      vector<CutSetOutput> m_vecOutputs;
 
       // histogram definitions
       SReadLambdaJetTreeHistDef m_hist;
 
+      // books jet/lambda histograms with the precision
+      // set by the histogram policy
+      SHistBooker m_booker;
+
+      // for counting types per event
+      vector<uint64_t> m_nEvt;
+
+      // bootstrap weights of current event
+      SReadLambdaJetTreeBootWeights m_bootWeights;
+
+      // per-event jet-lambda association index: lambdas associated
+      // with jet i are m_vecAssocLam[m_vecAssocStart[i]] through
+      // m_vecAssocLam[m_vecAssocStart[i + 1] - 1]
+      vector<size_t>             m_vecAssocStart;
+      vector<size_t>             m_vecAssocLam;
+      vector<size_t>             m_vecAssocCursor;
+      vector<int64_t>            m_vecLamJetIndex;
+      vector<double>             m_vecJetMaxLamZ;
+      unordered_map<int, size_t> m_mapJetIDOntoIndex;
+
+      // current event as contiguous per-object arrays
+      SReadLambdaJetTreeEvent m_event;
+
+      // selected range of entries (incl. shard)
+      SEntryRange m_range;
+
+      // entry range for this instance to process (last
+      // < 0 means through the end of the input)
+      int64_t m_firstEntry = 0;
+      int64_t m_lastEntry  = -1;
+
+      // entry no. of this instance's first input entry
+      // in the full input (workers given a group of
+      // files read them from entry 0), so replica
+      // weights don't depend on how input is split
+      int64_t m_entryOffset = 0;
+
+      // no. of entries and bytes read in event loop
+      int64_t m_nEvtsRead  = 0;
+      int64_t m_nBytesRead = 0;
+
+      // object tuple buffers: flags and values of each
+      // lambda and jet in the current event
+      TupleRow         m_row;
+      vector<UShort_t> m_vecLamFlags;
+      vector<UShort_t> m_vecJetFlags;
+      vector<Hist>     m_vecLamRows;
+      vector<Hist>     m_vecJetRows;
+
+      // skim output and manifest of source entries
+      TFile*       m_fSkim        = NULL;
+      TTree*       m_tSkim        = NULL;
+      TTree*       m_tSkimEntries = NULL;
+      Long64_t     m_skimSrcEntry = 0;
+      vector<bool> m_vecKeepJet;
+      vector<bool> m_vecKeepLam;
+
+      // writes checkpoints in the background
+      SCheckpointWriter* m_checkpoint = NULL;
+
+      // for multi-threaded running
+      bool                        m_isWorker = false;
+      SharedProgress*             m_shared   = NULL;
+      vector<SReadLambdaJetTree*> m_vecWorkers;
+
       // event-level input leaves
       int    m_evtNJets;
       int    m_evtNLambdas;
@@ -0,0 +1,213 @@
+// ----------------------------------------------------------------------------
+// 'SReadLambdaJetTreeBootstrap.h'
+// Derek Anderson
+// 04.12.2024
+//
+// Poisson-bootstrap replicas for the SReadLambdaJetTree
+// plugin: each event gets a weight ~ Poisson(1) per
+// replica, and the type counters and selected 1d
+// histograms are filled with those weights in the
+// same event loop as the nominal ones.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SREADLAMBDAJETTREEBOOTSTRAP_H
+#define SCORRELATORQAMAKER_SREADLAMBDAJETTREEBOOTSTRAP_H
+
+// c++ utilities
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+// root libraries
+#include <TH2.h>
+#include <TDirectory.h>
+// plugin definitions
+#include "SReadLambdaJetTreeHistDef.h"
+#include "SReadLambdaJetTreeFillTable.h"
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SReadLambdaJetTreeBootWeights definition ---------------------------------
+
+  struct SReadLambdaJetTreeBootWeights {
+
+    uint64_t       seed = 0;
+    vector<double> weights;
+
+    void Init(const size_t nReplicas, const uint64_t seedToUse) {
+
+      seed = seedToUse;
+      weights.assign(nReplicas, 1.);
+      return;
+
+    }  // end 'Init(size_t, uint64_t)'
+
+    void Generate(const int64_t iEvt) {
+
+      // weights only depend on seed and entry no., so
+      // they're the same however the input is split
+      // across threads or jobs
+      uint64_t state = seed ^ (0x9e3779b97f4a7c15ULL * (uint64_t) (iEvt + 1));
+      for (double& weight : weights) {
+
+        // draw k ~ Poisson(1) by inverting the cdf
+        const double u   = (double) (Next(state) >> 11) * 0x1.0p-53;
+        double       pK  = exp(-1.);
+        double       cdf = pK;
+        uint32_t     k   = 0;
+        while ((u > cdf) && (k < 20)) {
+          ++k;
+          pK  /= (double) k;
+          cdf += pK;
+        }
+        weight = (double) k;
+      }
+      return;
+
+    }  // end 'Generate(int64_t)'
+
+    // splitmix64 step
+    static uint64_t Next(uint64_t& state) {
+
+      uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+
+    }  // end 'Next(uint64_t&)'
+
+  };  // end SReadLambdaJetTreeBootWeights
+
+
+
+  // SReadLambdaJetTreeReplicas definition ------------------------------------
+
+  struct SReadLambdaJetTreeReplicas {
+
+    // bookkeeping
+    size_t nReplicas = 0;
+    size_t nTypes    = 0;
+    size_t nVars     = 0;
+
+    // binning of each variable
+    vector<SReadLambdaJetTreeFillTable::Axis> vecAxes;
+
+    // offset of each (type, var) array, or -1 if not
+    // replicated: each array holds the replicas of a
+    // bin next to each other, i.e. [bin][replica]
+    vector<int64_t> vecOffset;
+
+    // replica counts and per-type totals ([type][replica])
+    vector<double> vecCounts;
+    vector<double> vecTot;
+
+    void Init(const SReadLambdaJetTreeHistDef& def, const size_t nRep) {
+
+      nReplicas = nRep;
+      nTypes    = def.vecTypeNames.size();
+      nVars     = def.vecBaseNames.size();
+
+      vecAxes.clear();
+      for (const auto& axis : def.vecAxisDef) {
+        vecAxes.push_back({(int32_t) get<1>(axis), get<2>(axis).first, get<2>(axis).second});
+      }
+
+      size_t nCells = 0;
+      vecOffset.assign(nTypes * nVars, -1);
+      for (size_t iType = 0; iType < nTypes; iType++) {
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          if (!def.IsReplicated(iType, iVar)) continue;
+          vecOffset[(iType * nVars) + iVar] = nCells;
+          nCells += vecAxes[iVar].GetNCells() * nReplicas;
+        }
+      }
+      vecCounts.assign(nCells, 0.);
+      vecTot.assign(nTypes * nReplicas, 0.);
+      return;
+
+    }  // end 'Init(SReadLambdaJetTreeHistDef&, size_t)'
+
+    void Fill(const int type, const double* vals, const vector<double>& weights) {
+
+      double* tot = &vecTot[type * nReplicas];
+      for (size_t iRep = 0; iRep < nReplicas; iRep++) {
+        tot[iRep] += weights[iRep];
+      }
+
+      for (size_t iVar = 0; iVar < nVars; iVar++) {
+        const int64_t offset = vecOffset[(type * nVars) + iVar];
+        if (offset < 0) continue;
+
+        double* cell = &vecCounts[offset + (vecAxes[iVar].FindBin(vals[iVar]) * nReplicas)];
+        for (size_t iRep = 0; iRep < nReplicas; iRep++) {
+          cell[iRep] += weights[iRep];
+        }
+      }
+      return;
+
+    }  // end 'Fill(int, double*, vector<double>&)'
+
+    void Add(const SReadLambdaJetTreeReplicas& other) {
+
+      for (size_t iCell = 0; iCell < vecCounts.size(); iCell++) {
+        vecCounts[iCell] += other.vecCounts[iCell];
+      }
+      for (size_t iTot = 0; iTot < vecTot.size(); iTot++) {
+        vecTot[iTot] += other.vecTot[iTot];
+      }
+      return;
+
+    }  // end 'Add(SReadLambdaJetTreeReplicas&)'
+
+    void Write(TDirectory* dir, const SReadLambdaJetTreeHistDef& def) const {
+
+      // totals: x = type, y = replica (the spread over
+      // replicas is the uncertainty, so no sumw2: errors
+      // of bins are just sqrt(content), also once merged)
+      dir -> cd();
+      TH2D hTot("hNTotReplicas", ";type;replica", nTypes, 0., nTypes, nReplicas, 0., nReplicas);
+      hTot.Sumw2(false);
+      for (size_t iType = 0; iType < nTypes; iType++) {
+        hTot.GetXaxis() -> SetBinLabel(iType + 1, def.vecTypeNames[iType].data());
+        for (size_t iRep = 0; iRep < nReplicas; iRep++) {
+          hTot.SetBinContent(iType + 1, iRep + 1, vecTot[(iType * nReplicas) + iRep]);
+        }
+      }
+      hTot.Write();
+
+      // histograms: x = variable, y = replica
+      for (size_t iType = 0; iType < nTypes; iType++) {
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          const int64_t offset = vecOffset[(iType * nVars) + iVar];
+          if (offset < 0) continue;
+
+          const SReadLambdaJetTreeFillTable::Axis& axis = vecAxes[iVar];
+          const string sName  = def.vecBaseNames[iVar] + "_" + def.vecTypeNames[iType] + "_Replicas";
+          const string sTitle = ";" + get<0>(def.vecAxisDef[iVar]) + ";replica";
+
+          TH2D hRep(sName.data(), sTitle.data(), axis.nBins, axis.lo, axis.hi, nReplicas, 0., nReplicas);
+          hRep.Sumw2(false);
+          for (size_t iBin = 0; iBin < axis.GetNCells(); iBin++) {
+            for (size_t iRep = 0; iRep < nReplicas; iRep++) {
+              hRep.SetBinContent(iBin, iRep + 1, vecCounts[offset + (iBin * nReplicas) + iRep]);
+            }
+          }
+          hRep.Write();
+        }
+      }
+      return;
+
+    }  // end 'Write(TDirectory*, SReadLambdaJetTreeHistDef&)'
+
+  };  // end SReadLambdaJetTreeReplicas
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -11,6 +11,12 @@
 #ifndef SCORRELATORQAMAKER_SREADLAMBDAJETTREECONFIG_H
 #define SCORRELATORQAMAKER_SREADLAMBDAJETTREECONFIG_H
 
+// c++ utilities
+#include <string>
+#include <vector>
+// analysis utilities
+#include "SHistPolicy.h"
+
 // make common namespaces implicit
 using namespace std;
 
@@ -18,13 +24,140 @@ using namespace std;
 
 namespace SColdQcdCorrelatorAnalysis {
 
+  // SReadLambdaJetTreeCuts definition ----------------------------------------
+
+  struct SReadLambdaJetTreeCuts {
+
+    // name of output directory
+    string name {""};
+
+    // jet and lambda cuts
+    double ptJetMin  {0.2};
+    double ptLamMin  {0.2};
+    double etaJetMax {0.7};
+    double etaLamMax {1.1};
+    double zLeadMin  {0.5};
+
+  };  // end SReadLambdaJetTreeCuts
+
+
+
   // SReadLambdaJetTreeConfig definition --------------------------------------
 
   struct SReadLambdaJetTreeConfig {
 
-    // i/o options
-    string inFileName {""};
-    string inTreeName {""};
+    // i/o options: input file can be a single file,
+    // a glob (e.g. "output/*.root"), or a text file
+    // (.list or .txt) with one file or glob per line;
+    // anything in vecInFiles is chained too
+    string         inFileName {""};
+    string         inTreeName {""};
+    vector<string> vecInFiles {};
+
+    // input format: "ttree", "rntuple", or "auto" to
+    // pick it from the first input file; rntuple pages
+    // are decompressed in parallel over nUnzipThreads
+    // threads (0 to decompress in the reading thread);
+    // rdataframe and skim outputs need ttree input
+    string   inFormat      {"auto"};
+    uint16_t nUnzipThreads {0};
+
+    // input branches (or rntuple fields) to read:
+    // everything else is disabled (leave empty to
+    // read all branches)
+    vector<string> vecInBranches {
+      "JetNCst",
+      "JetID",
+      "JetE",
+      "JetPt",
+      "JetEta",
+      "JetPhi",
+      "LambdaJetID",
+      "LambdaZ",
+      "LambdaDr",
+      "LambdaEnergy",
+      "LambdaPt",
+      "LambdaEta",
+      "LambdaPhi"
+    };
+
+    // entries to process: [firstEntry, lastEntry) is
+    // split into nShards, of which shard iShard is
+    // processed (lastEntry < 0 means through the end)
+    int64_t  firstEntry {0};
+    int64_t  lastEntry  {-1};
+    uint32_t iShard     {0};
+    uint32_t nShards    {1};
+
+    // tree cache options (cache size in bytes, set
+    // to 0 to turn off)
+    int64_t cacheSize   {30000000};
+    int32_t nCacheLearn {100};
+
+    // seconds between progress updates
+    double progressInterval {10.};
+
+    // checkpointing: state is saved to checkpointFile
+    // every checkpointEvents entries or checkpointSeconds
+    // seconds (0 turns either off), and if resume is set
+    // the run picks up from the saved state
+    string   checkpointFile    {""};
+    uint64_t checkpointEvents  {0};
+    double   checkpointSeconds {0.};
+    bool     resume            {false};
+
+    // no. of threads to split the event loop over, and
+    // whether to give each thread whole input files
+    // rather than an equal range of entries
+    uint16_t nThreads    {1};
+    bool     splitByFile {false};
+
+    // fill histograms through a dense table of counts
+    // (histograms are then created only at the end)
+    bool useFillTable {true};
+
+    // fill each (type, var) family into one sparse
+    // histogram over (var, eta, E, pT, dphi, deta)
+    // instead, and project out the usual 1d and 2d
+    // histograms at the end (overrides useFillTable)
+    bool useSparse {false};
+
+    // histogram storage: precision of each family of
+    // histograms and total memory budget (covering
+    // every copy held at once, i.e. one per thread or
+    // a checkpoint snapshot on top); setting a budget
+    // turns off useFillTable and useRDataFrame
+    // (both keep dense doubles), and if overBudget is
+    // Sparse, going over it switches on useSparse, in
+    // which case memory grows with the no. of bins
+    // filled rather than being capped
+    SHistPolicy histPolicy {};
+
+    // run selections and fills as an rdataframe graph
+    // instead of the hand-written event loop (nThreads
+    // sets the implicit multithreading pool size; skim
+    // and tuple outputs need the hand-written loop)
+    bool useRDataFrame {false};
+
+    // no. of poisson-bootstrap replicas to fill for the
+    // type counters and replicated 1d histograms (0 to
+    // turn off), and seed for the per-event weights
+    uint32_t nReplicas   {0};
+    uint64_t replicaSeed {20240412};
+
+    // skim options: events with at least one lambda
+    // passing the cuts (of any cut set) are copied to
+    // a slim tree with only the branches read above;
+    // if skimObjects is set, only jets and lambdas
+    // passing the cuts are kept in those events
+    bool   doSkim       {false};
+    bool   skimObjects  {false};
+    string skimFileName {"lambdaJetTree.skim.root"};
+
+    // write a tuple with one row per selected object
+    // (lambda or jet) in each cut set's directory, so
+    // histograms can be remade without the jet tree
+    bool doTuple {false};
 
     // calculation options
     double ptJetMin  {0.2};
@@ -33,6 +166,20 @@ namespace SColdQcdCorrelatorAnalysis {
     double etaLamMax {1.1};
     double zLeadMin  {0.5};
 
+    // additional cut sets to fill in the same pass: each
+    // is saved in a subdirectory of the output named
+    // after the set (the cuts above go in the output
+    // directory itself)
+    vector<SReadLambdaJetTreeCuts> vecCutSets {};
+
+    // output options: compression settings for the
+    // output file (e.g. 404 for lz4, or -1 to leave
+    // as is), and whether to write each cut set's
+    // histograms as one key (a TList named "Hists")
+    // rather than one key per histogram
+    int32_t outCompression {-1};
+    bool    saveSingleKey  {false};
+
     // histogram options
     bool     centerTitle  {true};
     float    defOffX      {1.0};
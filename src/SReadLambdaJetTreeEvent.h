@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------------
+// 'SReadLambdaJetTreeEvent.h'
+// Derek Anderson
+// 04.17.2024
+//
+// SCorrelatorQAMaker plugin to read lambda-tagged jet
+// trees and draw plots and calculate the total no.
+// of lambdas.
+//
+// Per-event input view: jets and lambdas of the
+// current event as contiguous arrays (one per
+// variable), loaded once after each entry is read.
+// Cuts and angles wrt the highest pt jet are then
+// applied in one pass over each array instead of
+// per object.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SREADLAMBDAJETTREEEVENT_H
+#define SCORRELATORQAMAKER_SREADLAMBDAJETTREEEVENT_H
+
+// c++ utilities
+#include <cmath>
+#include <vector>
+#include <cstdint>
+// root libraries
+#include <TMath.h>
+// plugin definitions
+#include "SReadLambdaJetTreeConfig.h"
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SReadLambdaJetTreeEvent definition ---------------------------------------
+
+  struct SReadLambdaJetTreeEvent {
+
+    // jet arrays: kinematics point into the input
+    // vectors, counts are filled by Load
+    size_t         nJets  = 0;
+    const double*  jetEta = NULL;
+    const double*  jetEne = NULL;
+    const double*  jetPt  = NULL;
+    const double*  jetPhi = NULL;
+    vector<double> jetNCst;
+    vector<double> jetNLam;
+    vector<double> jetPLam;
+
+    // lambda arrays: all point into the input vectors
+    size_t        nLams  = 0;
+    const double* lamEta = NULL;
+    const double* lamEne = NULL;
+    const double* lamPt  = NULL;
+    const double* lamPhi = NULL;
+    const double* lamDr  = NULL;
+    const double* lamZ   = NULL;
+
+    // for the current set of cuts: whether each object
+    // passes, and its dphi, deta wrt the highest pt jet
+    vector<uint8_t> jetIsGood;
+    vector<uint8_t> lamIsGood;
+    vector<double>  jetDf;
+    vector<double>  jetDh;
+    vector<double>  lamDf;
+    vector<double>  lamDh;
+
+    void Load(
+      const vector<double>&   vecJetEta,
+      const vector<double>&   vecJetEne,
+      const vector<double>&   vecJetPt,
+      const vector<double>&   vecJetPhi,
+      const vector<uint64_t>& vecJetNCst,
+      const vector<size_t>&   vecAssocStart,
+      const vector<double>&   vecLamEta,
+      const vector<double>&   vecLamEne,
+      const vector<double>&   vecLamPt,
+      const vector<double>&   vecLamPhi,
+      const vector<double>&   vecLamDr,
+      const vector<double>&   vecLamZ
+    ) {
+
+      nJets  = vecJetPt.size();
+      jetEta = vecJetEta.data();
+      jetEne = vecJetEne.data();
+      jetPt  = vecJetPt.data();
+      jetPhi = vecJetPhi.data();
+
+      // counts of constituents and associated lambdas
+      // don't depend on the cuts, so do them once
+      jetNCst.resize(nJets);
+      jetNLam.resize(nJets);
+      jetPLam.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        jetNCst[iJet] = (double) vecJetNCst[iJet];
+        jetNLam[iJet] = (double) (vecAssocStart[iJet + 1] - vecAssocStart[iJet]);
+        jetPLam[iJet] = jetNLam[iJet] / jetNCst[iJet];
+      }
+
+      nLams  = vecLamPt.size();
+      lamEta = vecLamEta.data();
+      lamEne = vecLamEne.data();
+      lamPt  = vecLamPt.data();
+      lamPhi = vecLamPhi.data();
+      lamDr  = vecLamDr.data();
+      lamZ   = vecLamZ.data();
+      return;
+
+    }  // end 'Load(vector<double>&, ...)'
+
+    // flag objects passing cuts and return index of the
+    // highest pt good jet (nJets if there isn't one)
+    size_t Select(const SReadLambdaJetTreeCuts& cuts) {
+
+      jetIsGood.resize(nJets);
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        jetIsGood[iJet] = (jetPt[iJet] > cuts.ptJetMin) & (abs(jetEta[iJet]) < cuts.etaJetMax);
+      }
+
+      lamIsGood.resize(nLams);
+      for (size_t iLam = 0; iLam < nLams; iLam++) {
+        lamIsGood[iLam] = (lamPt[iLam] > cuts.ptLamMin) & (abs(lamEta[iLam]) < cuts.etaLamMax);
+      }
+
+      size_t iTop  = nJets;
+      double ptTop = 0.;
+      for (size_t iJet = 0; iJet < nJets; iJet++) {
+        if (jetIsGood[iJet] && (jetPt[iJet] > ptTop)) {
+          ptTop = jetPt[iJet];
+          iTop  = iJet;
+        }
+      }
+      return iTop;
+
+    }  // end 'Select(SReadLambdaJetTreeCuts&)'
+
+    // calculate dphi, deta of every object wrt jet iRef
+    void CalcDeltas(const size_t iRef) {
+
+      const double phiRef = (iRef < nJets) ? jetPhi[iRef] : 0.;
+      const double etaRef = (iRef < nJets) ? jetEta[iRef] : 0.;
+      CalcDeltas(nJets, jetPhi, jetEta, phiRef, etaRef, jetDf, jetDh);
+      CalcDeltas(nLams, lamPhi, lamEta, phiRef, etaRef, lamDf, lamDh);
+      return;
+
+    }  // end 'CalcDeltas(size_t)'
+
+    // same wrapping as SReadLambdaJetTree::GetDeltaPhi
+    static void CalcDeltas(
+      const size_t nObj,
+      const double* phi,
+      const double* eta,
+      const double phiRef,
+      const double etaRef,
+      vector<double>& df,
+      vector<double>& dh
+    ) {
+
+      df.resize(nObj);
+      dh.resize(nObj);
+      for (size_t iObj = 0; iObj < nObj; iObj++) {
+        double dPhi = phi[iObj] - phiRef;
+        dPhi += (dPhi < -TMath::Pi()) ? TMath::TwoPi() : 0.;
+        dPhi -= (dPhi >  TMath::Pi()) ? TMath::TwoPi() : 0.;
+        df[iObj] = dPhi;
+        dh[iObj] = eta[iObj] - etaRef;
+      }
+      return;
+
+    }  // end 'CalcDeltas(size_t, double*, double*, double, double, vector<double>&, vector<double>&)'
+
+  };  // end SReadLambdaJetTreeEvent
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
@@ -0,0 +1,281 @@
+// ----------------------------------------------------------------------------
+// 'SReadLambdaJetTreeFillTable.h'
+// Derek Anderson
+// 04.02.2024
+//
+// SCorrelatorQAMaker plugin to read lambda-tagged jet
+// trees and draw plots and calculate the total no.
+// of lambdas.
+//
+// Dense fill table: instead of filling each TH1D/TH2D
+// separately, the bin of every variable is found once
+// per object and counts are incremented in contiguous
+// arrays laid out as [type][var][vs][bin]. Histograms
+// are only created from the table at the end of the
+// run.
+// ----------------------------------------------------------------------------
+
+#ifndef SCORRELATORQAMAKER_SREADLAMBDAJETTREEFILLTABLE_H
+#define SCORRELATORQAMAKER_SREADLAMBDAJETTREEFILLTABLE_H
+
+// c++ utilities
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+// root libraries
+#include <TH1.h>
+// plugin definitions
+#include "SReadLambdaJetTreeHistDef.h"
+
+// make common namespaces implicit
+using namespace std;
+
+
+
+namespace SColdQcdCorrelatorAnalysis {
+
+  // SReadLambdaJetTreeFillTable definition -----------------------------------
+
+  struct SReadLambdaJetTreeFillTable {
+
+    // no. of stats kept per histogram (same as TH1/TH2::GetStats)
+    enum NStats {
+      Stats1D = 4,
+      Stats2D = 7
+    };
+
+    // fixed-width axis
+    struct Axis {
+      int32_t nBins = 1;
+      double  lo    = 0.;
+      double  hi    = 1.;
+
+      // same convention as TAxis::FindFixBin:
+      // 0 is underflow and nBins + 1 is overflow
+      int32_t FindBin(const double x) const {
+        if (x < lo)    return 0;
+        if (!(x < hi)) return nBins + 1;
+        return 1 + (int32_t) (nBins * (x - lo) / (hi - lo));
+      }
+      bool IsInRange(const int32_t bin) const {return ((bin > 0) && (bin <= nBins));}
+      size_t GetNCells() const {return (size_t) nBins + 2;}
+    };
+
+    // dimensions
+    size_t nTypes = 0;
+    size_t nVars  = 0;
+    size_t nVs    = 0;
+
+    // axes
+    vector<Axis> vecVarAxes;
+    vector<Axis> vecVsAxes;
+
+    // which histograms are filled and their
+    // offsets into the count arrays
+    vector<bool>   vecIs1DOn;
+    vector<bool>   vecIs2DOn;
+    vector<size_t> vecOffset1D;
+    vector<size_t> vecOffset2D;
+
+    // counts, stats, and no. of entries per type
+    vector<double>   vecCounts1D;
+    vector<double>   vecCounts2D;
+    vector<double>   vecStats1D;
+    vector<double>   vecStats2D;
+    vector<uint64_t> vecEntries;
+
+    // per-object scratch space
+    vector<int32_t> vecBinVar;
+    vector<int32_t> vecBinVs;
+
+    size_t GetIndex1D(const size_t type, const size_t var) const {return (type * nVars) + var;}
+    size_t GetIndex2D(const size_t type, const size_t var, const size_t vs) const {return (GetIndex1D(type, var) * nVs) + vs;}
+
+    void Init(const SReadLambdaJetTreeHistDef& def) {
+
+      // set dimensions
+      nTypes = def.vecTypeNames.size();
+      nVars  = def.vecAxisDef.size();
+      nVs    = def.vecVsDef.size();
+
+      // set axes
+      vecVarAxes.resize(nVars);
+      vecVsAxes.resize(nVs);
+      for (size_t iVar = 0; iVar < nVars; iVar++) {
+        vecVarAxes[iVar].nBins = get<1>(def.vecAxisDef[iVar]);
+        vecVarAxes[iVar].lo    = get<2>(def.vecAxisDef[iVar]).first;
+        vecVarAxes[iVar].hi    = get<2>(def.vecAxisDef[iVar]).second;
+      }
+      for (size_t iVs = 0; iVs < nVs; iVs++) {
+        vecVsAxes[iVs].nBins = get<1>(def.vecVsDef[iVs]);
+        vecVsAxes[iVs].lo    = get<2>(def.vecVsDef[iVs]).first;
+        vecVsAxes[iVs].hi    = get<2>(def.vecVsDef[iVs]).second;
+      }
+
+      // lay out wanted histograms contiguously
+      size_t nCells1D = 0;
+      size_t nCells2D = 0;
+      vecIs1DOn.assign(nTypes * nVars, false);
+      vecIs2DOn.assign(nTypes * nVars * nVs, false);
+      vecOffset1D.assign(nTypes * nVars, 0);
+      vecOffset2D.assign(nTypes * nVars * nVs, 0);
+      for (size_t iType = 0; iType < nTypes; iType++) {
+        for (size_t iVar = 0; iVar < nVars; iVar++) {
+          if (def.IsWanted(iType, iVar)) {
+            vecIs1DOn[GetIndex1D(iType, iVar)]   = true;
+            vecOffset1D[GetIndex1D(iType, iVar)] = nCells1D;
+            nCells1D += vecVarAxes[iVar].GetNCells();
+          }
+          for (size_t iVs = 0; iVs < nVs; iVs++) {
+            if (!def.IsWanted2D(iType, iVar, iVs)) continue;
+            vecIs2DOn[GetIndex2D(iType, iVar, iVs)]   = true;
+            vecOffset2D[GetIndex2D(iType, iVar, iVs)] = nCells2D;
+            nCells2D += vecVsAxes[iVs].GetNCells() * vecVarAxes[iVar].GetNCells();
+          }
+        }
+      }
+
+      // and allocate storage
+      vecCounts1D.assign(nCells1D, 0.);
+      vecCounts2D.assign(nCells2D, 0.);
+      vecStats1D.assign(nTypes * nVars * Stats1D, 0.);
+      vecStats2D.assign(nTypes * nVars * nVs * Stats2D, 0.);
+      vecEntries.assign(nTypes, 0);
+      vecBinVar.resize(nVars);
+      vecBinVs.resize(nVs);
+      return;
+
+    }  // end 'Init(SReadLambdaJetTreeHistDef&)'
+
+    void Fill(const size_t type, const double* vals, const double* vsVals) {
+
+      // find each bin once
+      for (size_t iVar = 0; iVar < nVars; iVar++) {
+        vecBinVar[iVar] = vecVarAxes[iVar].FindBin(vals[iVar]);
+      }
+      for (size_t iVs = 0; iVs < nVs; iVs++) {
+        vecBinVs[iVs] = vecVsAxes[iVs].FindBin(vsVals[iVs]);
+      }
+      ++vecEntries[type];
+
+      // then increment counts and stats
+      for (size_t iVar = 0; iVar < nVars; iVar++) {
+
+        const size_t  i1D   = GetIndex1D(type, iVar);
+        const int32_t binY  = vecBinVar[iVar];
+        const bool    isInY = vecVarAxes[iVar].IsInRange(binY);
+        const double  y     = vals[iVar];
+        if (vecIs1DOn[i1D]) {
+          vecCounts1D[vecOffset1D[i1D] + binY] += 1.;
+          if (isInY) {
+            double* stats = &vecStats1D[i1D * Stats1D];
+            stats[0] += 1.;
+            stats[1] += 1.;
+            stats[2] += y;
+            stats[3] += y * y;
+          }
+        }
+
+        for (size_t iVs = 0; iVs < nVs; iVs++) {
+
+          const size_t  i2D  = GetIndex2D(type, iVar, iVs);
+          if (!vecIs2DOn[i2D]) continue;
+
+          const int32_t binX = vecBinVs[iVs];
+          const double  x    = vsVals[iVs];
+          vecCounts2D[vecOffset2D[i2D] + binX + (vecVsAxes[iVs].GetNCells() * binY)] += 1.;
+          if (isInY && vecVsAxes[iVs].IsInRange(binX)) {
+            double* stats = &vecStats2D[i2D * Stats2D];
+            stats[0] += 1.;
+            stats[1] += 1.;
+            stats[2] += x;
+            stats[3] += x * x;
+            stats[4] += y;
+            stats[5] += y * y;
+            stats[6] += x * y;
+          }
+        }  // end vs loop
+      }  // end variable loop
+      return;
+
+    }  // end 'Fill(size_t, double*, double*)'
+
+    void Add(const SReadLambdaJetTreeFillTable& other) {
+
+      for (size_t iCell = 0; iCell < vecCounts1D.size(); iCell++) vecCounts1D[iCell] += other.vecCounts1D[iCell];
+      for (size_t iCell = 0; iCell < vecCounts2D.size(); iCell++) vecCounts2D[iCell] += other.vecCounts2D[iCell];
+      for (size_t iStat = 0; iStat < vecStats1D.size(); iStat++)  vecStats1D[iStat]  += other.vecStats1D[iStat];
+      for (size_t iStat = 0; iStat < vecStats2D.size(); iStat++)  vecStats2D[iStat]  += other.vecStats2D[iStat];
+      for (size_t iType = 0; iType < vecEntries.size(); iType++)  vecEntries[iType]  += other.vecEntries[iType];
+      return;
+
+    }  // end 'Add(SReadLambdaJetTreeFillTable&)'
+
+    void Materialize1D(const size_t type, const size_t var, TH1* hist) const {
+
+      const size_t i1D = GetIndex1D(type, var);
+      if (!vecIs1DOn[i1D] || !hist) return;
+
+      // integer histograms have no sumw2 (setting errors
+      // would allocate it), and their errors are already
+      // sqrt(counts)
+      const bool    hasSumw2 = (hist -> GetSumw2N() > 0);
+      const double* counts   = &vecCounts1D[vecOffset1D[i1D]];
+      for (size_t iCell = 0; iCell < vecVarAxes[var].GetNCells(); iCell++) {
+        hist -> SetBinContent(iCell, counts[iCell]);
+        if (hasSumw2) hist -> SetBinError(iCell, sqrt(counts[iCell]));
+      }
+
+      // stats have to be set after contents
+      double stats[Stats1D];
+      copy(&vecStats1D[i1D * Stats1D], &vecStats1D[i1D * Stats1D] + Stats1D, stats);
+      hist -> PutStats(stats);
+      hist -> SetEntries(vecEntries[type]);
+      return;
+
+    }  // end 'Materialize1D(size_t, size_t, TH1*)'
+
+    void Materialize2D(const size_t type, const size_t var, const size_t vs, TH1* hist) const {
+
+      const size_t i2D = GetIndex2D(type, var, vs);
+      if (!vecIs2DOn[i2D] || !hist) return;
+
+      const bool    hasSumw2 = (hist -> GetSumw2N() > 0);
+      const size_t  nCells   = vecVsAxes[vs].GetNCells() * vecVarAxes[var].GetNCells();
+      const double* counts   = &vecCounts2D[vecOffset2D[i2D]];
+      for (size_t iCell = 0; iCell < nCells; iCell++) {
+        hist -> SetBinContent(iCell, counts[iCell]);
+        if (hasSumw2) hist -> SetBinError(iCell, sqrt(counts[iCell]));
+      }
+
+      // stats have to be set after contents
+      double stats[Stats2D];
+      copy(&vecStats2D[i2D * Stats2D], &vecStats2D[i2D * Stats2D] + Stats2D, stats);
+      hist -> PutStats(stats);
+      hist -> SetEntries(vecEntries[type]);
+      return;
+
+    }  // end 'Materialize2D(size_t, size_t, size_t, TH1*)'
+
+    void Clear() {
+
+      vector<double>().swap(vecCounts1D);
+      vector<double>().swap(vecCounts2D);
+      vector<double>().swap(vecStats1D);
+      vector<double>().swap(vecStats2D);
+      return;
+
+    }  // end 'Clear()'
+
+    size_t GetMemory() const {
+      return sizeof(double) * (vecCounts1D.size() + vecCounts2D.size() + vecStats1D.size() + vecStats2D.size());
+    }
+
+  };  // end SReadLambdaJetTreeFillTable
+
+}  // end SColdQcdCorrelatorAnalysis namespace
+
+#endif
+
+// end ------------------------------------------------------------------------
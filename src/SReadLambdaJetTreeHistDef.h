@@ -11,6 +11,13 @@
 #ifndef SCORRELATORQAMAKER_SREADLAMBDAJETTREEHISTDEF_H
 #define SCORRELATORQAMAKER_SREADLAMBDAJETTREEHISTDEF_H
 
+// c++ utilities
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <fnmatch.h>
+
 // make common namespaces implicit
 using namespace std;
 
@@ -103,6 +110,51 @@ namespace SColdQcdCorrelatorAnalysis {
       make_tuple("#Delta#eta",      nDhBins,   rDhBins)
     };
 
+    // (type, variable, vs) combinations to book: names
+    // are matched against the lists above, "*" can be
+    // used as a wildcard, and an empty vs only selects
+    // the 1d histogram, e.g.
+    //   {"Jet", "hPt", ""}       = 1d jet pt only
+    //   {"Lam", "*",   "VsPt"}   = all lambda vs. pt hists
+    //   {"*",   "*",   "*"}      = everything
+    vector<tuple<string, string, string>> vecToBook = {
+      make_tuple("*", "*", "*")
+    };
+
+    bool IsWanted(const size_t iType, const size_t iVar, const string vs = "") const {
+
+      for (const auto& book : vecToBook) {
+        const bool isTypeMatch = (fnmatch(get<0>(book).data(), vecTypeNames[iType].data(), 0) == 0);
+        const bool isVarMatch  = (fnmatch(get<1>(book).data(), vecBaseNames[iVar].data(), 0) == 0);
+        const bool isVsMatch   = (fnmatch(get<2>(book).data(), vs.data(), 0) == 0);
+        if (isTypeMatch && isVarMatch && isVsMatch) return true;
+      }
+      return false;
+
+    }  // end 'IsWanted(size_t, size_t, string)'
+
+    bool IsWanted2D(const size_t iType, const size_t iVar, const size_t iVs) const {
+      return IsWanted(iType, iVar, vecVsMods[iVs]);
+    }
+
+    // (type, variable) 1d histograms to fill bootstrap
+    // replicas of (if any are requested), matched the
+    // same way as above
+    vector<pair<string, string>> vecToReplicate = {
+      make_pair("*", "hPt")
+    };
+
+    bool IsReplicated(const size_t iType, const size_t iVar) const {
+
+      for (const auto& rep : vecToReplicate) {
+        const bool isTypeMatch = (fnmatch(rep.first.data(),  vecTypeNames[iType].data(), 0) == 0);
+        const bool isVarMatch  = (fnmatch(rep.second.data(), vecBaseNames[iVar].data(), 0) == 0);
+        if (isTypeMatch && isVarMatch) return true;
+      }
+      return false;
+
+    }  // end 'IsReplicated(size_t, size_t)'
+
   };  // end SReadLambdaJetTreeHistDef
 
   // variables to histogram